@@ -33,7 +33,8 @@ void registerAST(py::module_& m) {
         .value("CacheResults", EvalFlags::CacheResults)
         .value("SpecparamsAllowed", EvalFlags::SpecparamsAllowed)
         .value("CovergroupExpr", EvalFlags::CovergroupExpr)
-        .value("AllowUnboundedPlaceholder", EvalFlags::AllowUnboundedPlaceholder);
+        .value("AllowUnboundedPlaceholder", EvalFlags::AllowUnboundedPlaceholder)
+        .value("DeferCaching", EvalFlags::DeferCaching);
 
     py::class_<EvalContext> evalCtx(m, "EvalContext");
     evalCtx
@@ -70,6 +70,7 @@ void registerCompilation(py::module_& m) {
         .def_readwrite("maxInstanceArray", &CompilationOptions::maxInstanceArray)
         .def_readwrite("errorLimit", &CompilationOptions::errorLimit)
         .def_readwrite("typoCorrectionLimit", &CompilationOptions::typoCorrectionLimit)
+        .def_readwrite("numThreads", &CompilationOptions::numThreads)
         .def_readwrite("minTypMax", &CompilationOptions::minTypMax)
         .def_readwrite("languageVersion", &CompilationOptions::languageVersion)
         .def_readwrite("defaultTimeScale", &CompilationOptions::defaultTimeScale)
@@ -100,6 +101,7 @@ void registerCompilation(py::module_& m) {
         .def("getSemanticDiagnostics", &Compilation::getSemanticDiagnostics, byrefint)
         .def("getAllDiagnostics", &Compilation::getAllDiagnostics, byrefint)
         .def("addDiagnostics", &Compilation::addDiagnostics, "diagnostics"_a)
+        .def("getNumFilteredDiagnostics", &Compilation::getNumFilteredDiagnostics)
         .def("getCompilationUnit", &Compilation::getCompilationUnit, byrefint, "syntax"_a)
         .def("getCompilationUnits", &Compilation::getCompilationUnits, byrefint)
         .def("getSourceLibrary", &Compilation::getSourceLibrary, byrefint, "name"_a)
@@ -124,6 +126,9 @@ void registerCompilation(py::module_& m) {
         .def("getType", py::overload_cast<SyntaxKind>(&Compilation::getType, py::const_), byrefint,
              "kind"_a)
         .def("getNetType", &Compilation::getNetType, byrefint, "kind"_a)
+        .def("getInternedConstantBytesSaved", &Compilation::getInternedConstantBytesSaved)
+        .def("checkTypeRelation", &Compilation::checkTypeRelation, "lhs"_a, "rhs"_a, "relation"_a)
+        .def("getTypeRelationCacheStats", &Compilation::getTypeRelationCacheStats)
         .def_property_readonly("defaultTimeScale", &Compilation::getDefaultTimeScale)
         .def_property_readonly("bitType", &Compilation::getBitType)
         .def_property_readonly("logicType", &Compilation::getLogicType)
@@ -141,6 +146,11 @@ void registerCompilation(py::module_& m) {
         .def_property_readonly("typeRefType", &Compilation::getTypeRefType)
         .def_property_readonly("wireNetType", &Compilation::getWireNetType);
 
+    py::class_<Compilation::TypeRelationCacheStats>(comp, "TypeRelationCacheStats")
+        .def(py::init<>())
+        .def_readonly("hits", &Compilation::TypeRelationCacheStats::hits)
+        .def_readonly("misses", &Compilation::TypeRelationCacheStats::misses);
+
     py::class_<Compilation::DefinitionLookupResult>(comp, "DefinitionLookupResult")
         .def(py::init<>())
         .def_readwrite("definition", &Compilation::DefinitionLookupResult::definition)
@@ -199,7 +209,8 @@ void registerCompilation(py::module_& m) {
         .def_readwrite("numThreads", &SourceOptions::numThreads)
         .def_readwrite("singleUnit", &SourceOptions::singleUnit)
         .def_readwrite("onlyLint", &SourceOptions::onlyLint)
-        .def_readwrite("librariesInheritMacros", &SourceOptions::librariesInheritMacros);
+        .def_readwrite("librariesInheritMacros", &SourceOptions::librariesInheritMacros)
+        .def_readwrite("deferLibraryBodies", &SourceOptions::deferLibraryBodies);
 
     py::class_<SourceLoader> sourceLoader(m, "SourceLoader");
     sourceLoader.def(py::init<SourceManager&>(), "sourceManager"_a)
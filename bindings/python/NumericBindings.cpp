@@ -309,8 +309,8 @@ void registerNumeric(py::module_& m) {
                         return py::cast(arg);
                     else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                         return py::cast(arg);
-                    else if constexpr (std::is_same_v<T, ConstantValue::Elements>)
-                        return py::cast(arg);
+                    else if constexpr (std::is_same_v<T, ConstantValue::ElementsPtr>)
+                        return py::cast(*arg);
                     else if constexpr (std::is_same_v<T, std::string>)
                         return py::cast(arg);
                     else if constexpr (std::is_same_v<T, ConstantValue::Map>)
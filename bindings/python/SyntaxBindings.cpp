@@ -273,6 +273,8 @@ void registerSyntax(py::module_& m) {
                     "options"_a = Bag(), "library"_a = nullptr)
         .def_static("fromFileInMemory", &SyntaxTree::fromFileInMemory, "text"_a, "sourceManager"_a,
                     "name"_a = "source", "path"_a = "", "options"_a = Bag())
+        .def_static("fromTextEdit", &SyntaxTree::fromTextEdit, "oldTree"_a, "offset"_a,
+                    "length"_a, "newText"_a, "name"_a = "source", "path"_a = "")
         .def_static("fromBuffer", &SyntaxTree::fromBuffer, "buffer"_a, "sourceManager"_a,
                     "options"_a = Bag(), "inheritedMacros"_a = SyntaxTree::MacroList{})
         .def_static("fromBuffers", &SyntaxTree::fromBuffers, "buffers"_a, "sourceManager"_a,
@@ -310,7 +312,8 @@ void registerSyntax(py::module_& m) {
     py::class_<ParserOptions>(m, "ParserOptions")
         .def(py::init<>())
         .def_readwrite("maxRecursionDepth", &ParserOptions::maxRecursionDepth)
-        .def_readwrite("languageVersion", &ParserOptions::languageVersion);
+        .def_readwrite("languageVersion", &ParserOptions::languageVersion)
+        .def_readwrite("deferModuleBodies", &ParserOptions::deferModuleBodies);
 
     py::class_<SyntaxPrinter>(m, "SyntaxPrinter")
         .def(py::init<>())
@@ -19,6 +19,12 @@ void registerTypes(py::module_& m) {
         .value("FourState", IntegralFlags::FourState)
         .value("Reg", IntegralFlags::Reg);
 
+    py::enum_<TypeRelation>(m, "TypeRelation")
+        .value("Matching", TypeRelation::Matching)
+        .value("Equivalent", TypeRelation::Equivalent)
+        .value("AssignmentCompatible", TypeRelation::AssignmentCompatible)
+        .value("CastCompatible", TypeRelation::CastCompatible);
+
     py::class_<Type, Symbol>(m, "Type")
         .def_property_readonly("canonicalType", &Type::getCanonicalType)
         .def_property_readonly("bitWidth", &Type::getBitWidth)
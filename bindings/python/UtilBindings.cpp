@@ -10,6 +10,7 @@
 #include "slang/diagnostics/DiagnosticClient.h"
 #include "slang/diagnostics/DiagnosticEngine.h"
 #include "slang/diagnostics/Diagnostics.h"
+#include "slang/diagnostics/JsonDiagnosticClient.h"
 #include "slang/diagnostics/TextDiagnosticClient.h"
 #include "slang/parsing/Lexer.h"
 #include "slang/parsing/Parser.h"
@@ -270,6 +271,7 @@ void registerUtil(py::module_& m) {
                  &DiagnosticEngine::setSeverity),
              "group"_a, "severity"_a)
         .def("getSeverity", &DiagnosticEngine::getSeverity, "code"_a, "location"_a)
+        .def("isSuppressed", &DiagnosticEngine::isSuppressed, "code"_a, "location"_a)
         .def("setMessage", &DiagnosticEngine::setMessage, "code"_a, "message"_a)
         .def("getMessage", &DiagnosticEngine::getMessage, "code"_a)
         .def("getOptionName", &DiagnosticEngine::getOptionName, "code"_a)
@@ -318,4 +320,11 @@ void registerUtil(py::module_& m) {
         .def("report", &TextDiagnosticClient::report, "diag"_a)
         .def("clear", &TextDiagnosticClient::clear)
         .def("getString", &TextDiagnosticClient::getString);
+
+    py::class_<JsonDiagnosticClient, DiagnosticClient, std::shared_ptr<JsonDiagnosticClient>>(
+        m, "JsonDiagnosticClient")
+        .def(py::init<>())
+        .def("report", &JsonDiagnosticClient::report, "diag"_a)
+        .def("clear", &JsonDiagnosticClient::clear)
+        .def("getString", &JsonDiagnosticClient::getString);
 }
@@ -233,9 +233,15 @@ enum class SLANG_EXPORT EvalFlags : uint8_t {
     /// For parameter evaluation, allow unbounded literals to evaluate to
     /// the placeholder value. Other expressions that have an unbounded literal
     /// without a queue target will return an invalid value.
-    AllowUnboundedPlaceholder = 1 << 4
+    AllowUnboundedPlaceholder = 1 << 4,
+
+    /// Results that would be cached in each expression's `constant` pointer
+    /// (when @a CacheResults is set) are instead recorded in the evaluation
+    /// context and applied later, so that the evaluation doesn't modify the AST.
+    /// This allows independent expressions to be evaluated concurrently.
+    DeferCaching = 1 << 5
 };
-SLANG_BITMASK(EvalFlags, AllowUnboundedPlaceholder)
+SLANG_BITMASK(EvalFlags, DeferCaching)
 
 /// The result of evaluating dimension syntax nodes.
 struct SLANG_EXPORT EvaluatedDimension {
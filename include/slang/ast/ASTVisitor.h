@@ -52,7 +52,17 @@ concept HasVisitExprs = requires(const T& t, TVisitor&& visitor) { t.visitExprs(
 /// visited -- you can include that behavior by invoking @a visitDefault
 /// in your handler.
 ///
-template<typename TDerived, bool VisitStatements, bool VisitExpressions, bool VisitBad = false>
+/// If @a ExplicitStack is set to true, @a visitDefault walks the children
+/// of a node using a heap allocated work list instead of recursing into each
+/// one. Handlers are invoked in exactly the same order as in the recursive
+/// mode, but only nodes that have a handler cost a native stack frame, which
+/// allows visiting very deep expression trees (e.g. long chains of binary
+/// operators) without running out of stack space. Derived classes that
+/// hide visit() itself should not use this mode, since nodes popped off of
+/// the work list are dispatched to their handlers directly.
+///
+template<typename TDerived, bool VisitStatements, bool VisitExpressions, bool VisitBad = false,
+         bool ExplicitStack = false>
 class ASTVisitor {
 #define DERIVED *static_cast<TDerived*>(this)
 public:
@@ -76,35 +86,100 @@ public:
     /// You can invoke this from custom node handlers to get the default behavior.
     template<typename T>
     void visitDefault(const T& t) {
-        if constexpr (VisitExpressions && HasVisitExprs<T, TDerived>) {
-            t.visitExprs(DERIVED);
+        if constexpr (ExplicitStack) {
+            SmallVector<StackEntry> stack;
+            pushChildren(t, stack);
+
+            while (!stack.empty()) {
+                auto entry = stack.back();
+                stack.pop_back();
+                entry.visit(DERIVED, entry.node, stack);
+            }
+        }
+        else {
+            visitChildren(t, DERIVED);
+        }
+    }
+
+private:
+    template<typename T, typename TVisitor>
+    static void visitChildren(const T& t, TVisitor& visitor) {
+        if constexpr (VisitExpressions && HasVisitExprs<T, TVisitor>) {
+            t.visitExprs(visitor);
         }
 
-        if constexpr (VisitStatements && requires { t.visitStmts(DERIVED); }) {
-            t.visitStmts(DERIVED);
+        if constexpr (VisitStatements && requires { t.visitStmts(visitor); }) {
+            t.visitStmts(visitor);
         }
 
         if constexpr (VisitExpressions && std::is_base_of_v<Symbol, T>) {
             if (auto declaredType = t.getDeclaredType()) {
                 if (auto init = declaredType->getInitializer())
-                    init->visit(DERIVED);
+                    init->visit(visitor);
             }
         }
 
         if constexpr (std::is_base_of_v<GenericClassDefSymbol, T>) {
             for (auto&& spec : t.specializations())
-                spec.visit(DERIVED);
+                spec.visit(visitor);
         }
 
         if constexpr (std::is_base_of_v<Scope, T>) {
             for (auto& member : t.members())
-                member.visit(DERIVED);
+                member.visit(visitor);
         }
 
         if constexpr (std::is_same_v<InstanceSymbol, T> ||
                       std::is_same_v<CheckerInstanceSymbol, T>) {
-            t.body.visit(DERIVED);
+            t.body.visit(visitor);
+        }
+    }
+
+    // A pending node in explicit stack mode, along with a function that
+    // knows how to visit it given its static type.
+    struct StackEntry {
+        const void* node;
+        void (*visit)(TDerived& derived, const void* node, SmallVectorBase<StackEntry>& stack);
+    };
+
+    // Stands in for the derived visitor when collecting the children of a node;
+    // each child is recorded instead of being visited right away.
+    struct Collector {
+        SmallVectorBase<StackEntry>& stack;
+
+        template<typename T>
+        void visit(const T& t) {
+            stack.push_back({&t, &visitEntry<T>});
         }
+    };
+
+    // Pushes the children of the given node in reverse so that
+    // they get popped back off in their original order.
+    template<typename T>
+    static void pushChildren(const T& t, SmallVectorBase<StackEntry>& stack) {
+        size_t start = stack.size();
+        Collector collector{stack};
+        visitChildren(t, collector);
+        std::reverse(stack.begin() + ptrdiff_t(start), stack.end());
+    }
+
+    // Mirrors visit() for a node popped off of the stack, except that nodes
+    // without a handler have their children pushed instead of recursing.
+    template<typename T>
+    static void visitEntry(TDerived& derived, const void* node,
+                           SmallVectorBase<StackEntry>& stack) {
+        auto& t = *static_cast<const T*>(node);
+        if constexpr (!VisitBad && requires { t.bad(); }) {
+            if (t.bad())
+                return;
+        }
+
+        if constexpr (requires { derived.handle(t); })
+            derived.handle(t);
+        else if constexpr (requires { derived(derived, t); })
+            derived(derived, t);
+        else
+            pushChildren(t, stack);
     }
 
 #undef DERIVED
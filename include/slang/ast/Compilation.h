@@ -7,6 +7,8 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
 
 #include "slang/ast/OpaqueInstancePath.h"
@@ -17,6 +19,7 @@
 #include "slang/syntax/SyntaxNode.h"
 #include "slang/util/Bag.h"
 #include "slang/util/BumpAllocator.h"
+#include "slang/util/Function.h"
 #include "slang/util/IntervalMap.h"
 #include "slang/util/LanguageVersion.h"
 #include "slang/util/SafeIndexedVector.h"
@@ -48,6 +51,7 @@ class SystemSubroutine;
 class ValueDriver;
 struct AssertionInstanceDetails;
 struct ConfigRule;
+struct DiagnosticVisitor;
 struct ResolvedConfig;
 
 using DriverIntervalMap = IntervalMap<uint64_t, const ValueDriver*>;
@@ -56,6 +60,7 @@ using UnrollIntervalMap = IntervalMap<uint64_t, std::monostate>;
 enum class IntegralFlags : uint8_t;
 enum class SymbolIndex : uint32_t;
 enum class SymbolKind : int;
+enum class TypeRelation : uint8_t;
 enum class UnconnectedDrive;
 
 /// Specifies which set of min:typ:max expressions should
@@ -178,8 +183,15 @@ struct SLANG_EXPORT CompilationOptions {
 
     /// The maximum number of times we'll attempt to do typo correction before
     /// giving up. This is to prevent very slow compilation times if the
-    /// source text is hopelessly broken.
-    uint32_t typoCorrectionLimit = 32;
+    /// source text is hopelessly broken. Candidates are found through a
+    /// per-scope index of member names, so each attempt is fairly cheap.
+    uint32_t typoCorrectionLimit = 1024;
+
+    /// The number of threads to use for elaboration work that can be done
+    /// concurrently, such as evaluating large numbers of independent parameter
+    /// initializers. Zero means to use the number of concurrent threads supported
+    /// by the system, and one disables the use of additional threads.
+    uint32_t numThreads = 1;
 
     /// Specifies which set of min:typ:max expressions should
     /// be used during compilation.
@@ -319,6 +331,34 @@ public:
     /// Gets all of the diagnostics produced during compilation.
     const Diagnostics& getAllDiagnostics();
 
+    /// Elaborates only the part of the design affected by a change to the given
+    /// syntax trees, as a cheaper alternative to @a getSemanticDiagnostics for
+    /// interactive use. The expected flow is to create a new compilation that shares
+    /// all unchanged syntax trees with the previous one, swapping in just the edited
+    /// trees, and then to call this method with those edited trees.
+    ///
+    /// A tree is affected if it is one of @a changedTrees or if it refers by name
+    /// (via instantiations, package imports, interface ports, or scoped names) to a
+    /// definition, package, or class declared in another affected tree, or declared
+    /// in one of @a previousTrees, which should be the versions of the changed trees
+    /// from the previous compilation. Compilation units and instance bodies whose
+    /// definitions are declared in affected trees are fully elaborated, along with
+    /// every instance body beneath them in the hierarchy, and the same checks that
+    /// @a getSemanticDiagnostics runs after elaboration are applied to them. Only
+    /// their diagnostics are returned; diagnostics from the previous compilation for
+    /// all other design elements still apply.
+    ///
+    /// Instance bodies whose definitions can't contain an affected instance, judging
+    /// by the names they instantiate, are skipped without elaborating their members.
+    /// Designs with bind directives are walked in full since binds can add instances
+    /// anywhere in the hierarchy.
+    ///
+    /// @note Dependencies that are only expressed through hierarchical references
+    /// are not tracked.
+    Diagnostics elaborateIncremental(
+        std::span<const std::shared_ptr<syntax::SyntaxTree>> changedTrees,
+        std::span<const std::shared_ptr<syntax::SyntaxTree>> previousTrees = {});
+
     /// @}
     /// @name Utility and convenience methods
     /// @{
@@ -576,6 +616,23 @@ public:
     /// Adds a set of diagnostics to the compilation's list of semantic diagnostics.
     void addDiagnostics(const Diagnostics& diagnostics);
 
+    /// Sets a filter that is consulted whenever a diagnostic is created. Non-error
+    /// diagnostics for which the filter returns true are dropped immediately, before
+    /// any arguments are attached or any storage is allocated for them.
+    template<typename TFunc>
+    void setDiagnosticFilter(TFunc&& func) {
+        diagFilter = std::forward<TFunc>(func);
+    }
+
+    /// Gets the number of diagnostics that have been dropped by the filter
+    /// set via @a setDiagnosticFilter
+    size_t getNumFilteredDiagnostics() const { return numFilteredDiags; }
+
+    /// If the given diagnostic would be dropped by the diagnostic filter, returns
+    /// a scratch diagnostic that callers can fill in and that will be discarded.
+    /// Otherwise returns nullptr.
+    Diagnostic* filterDiag(DiagCode code, SourceLocation location);
+
     /// Forces the given symbol and all scopes underneath it to
     /// be elaborated and any relevant diagnostics to be issued.
     void forceElaborate(const Symbol& symbol);
@@ -615,6 +672,42 @@ public:
     /// Gets a scalar (single bit) type with the given flags.
     const Type& getScalarType(bitmask<IntegralFlags> flags);
 
+    /// Checks whether the given types satisfy the specified relation. Results for
+    /// non-trivial queries are remembered in a bounded cache keyed on the canonical
+    /// types involved, so repeated checks between the same types are cheap.
+    bool checkTypeRelation(const Type& lhs, const Type& rhs, TypeRelation relation);
+
+    /// Statistics about the use of the type relation cache. The counters are
+    /// updated atomically, so they're accurate even if types are checked from
+    /// multiple threads, but they should only be read once those threads are done.
+    struct TypeRelationCacheStats {
+        /// The number of queries answered from the cache.
+        uint64_t hits = 0;
+
+        /// The number of queries that had to be computed.
+        uint64_t misses = 0;
+    };
+
+    /// Gets statistics about the use of the type relation cache
+    /// by @a checkTypeRelation.
+    const TypeRelationCacheStats& getTypeRelationCacheStats() const {
+        return typeRelationCacheStats;
+    }
+
+    /// Gets a packed array type with the given element type and range.
+    /// Array types are interned, so identical arrays declared by the same
+    /// syntax node (if any) share the same type object.
+    /// The caller is responsible for ensuring that the total width is valid.
+    const Type& getPackedArrayType(const Type& elementType, ConstantRange range,
+                                   const syntax::SyntaxNode* syntax = nullptr);
+
+    /// Gets a fixed size unpacked array type with the given element type and range.
+    /// Array types are interned, so identical arrays declared by the same
+    /// syntax node (if any) share the same type object.
+    /// The caller is responsible for ensuring that the total width is valid.
+    const Type& getUnpackedArrayType(const Type& elementType, ConstantRange range,
+                                     const syntax::SyntaxNode* syntax = nullptr);
+
     /// Gets the nettype represented by the given token kind.
     /// If the token kind does not represent a nettype this will return the
     /// error nettype.
@@ -672,9 +765,13 @@ public:
     /// @{
 
     /// Allocates space for a constant value in the pool of constants.
-    ConstantValue* allocConstant(ConstantValue&& value) {
-        return constantAllocator.emplace(std::move(value));
-    }
+    /// Simple immutable values (integers, reals, and short strings) are interned
+    /// so that identical values share a single allocation.
+    const ConstantValue* allocConstant(ConstantValue&& value);
+
+    /// Gets the number of bytes of constant storage that have been saved
+    /// by interning identical values in @a allocConstant.
+    size_t getInternedConstantBytesSaved() const { return internedConstantBytesSaved; }
 
     /// Allocates a symbol map.
     SymbolMap* allocSymbolMap() { return symbolMapAllocator.emplace(); }
@@ -734,9 +831,12 @@ private:
     std::span<const AttributeSymbol* const> getAttributes(const void* ptr) const;
 
     Diagnostic& addDiag(Diagnostic diag);
+    Diagnostics collectSemanticDiags(function_ref<bool(const Diagnostic&)> filter);
 
     const RootSymbol& getRoot(bool skipDefParamsAndBinds);
     void elaborate();
+    void finishElaboration(DiagnosticVisitor& elabVisitor,
+                           std::span<const Symbol* const> postElabRoots);
     void insertDefinition(Symbol& symbol, const Scope& scope);
     void parseParamOverrides(flat_hash_map<std::string_view, const ConstantValue*>& results);
     void checkDPIMethods(std::span<const SubroutineSymbol* const> dpiImports);
@@ -754,6 +854,8 @@ private:
     std::pair<DefinitionLookupResult, bool> resolveConfigRules(
         std::string_view name, const Scope& scope, const ResolvedConfig* parentConfig,
         const ConfigRule* configRule, const std::vector<Symbol*>& defList) const;
+    DefinitionLookupResult findDefinition(std::string_view name, const Scope& scope) const;
+    void parseDeferredBody(const Symbol* symbol) const;
     Diagnostic* errorMissingDef(std::string_view name, const Scope& scope, SourceRange sourceRange,
                                 DiagCode code) const;
 
@@ -804,6 +906,55 @@ private:
     // A cache of vector types, keyed on various properties such as bit width.
     flat_hash_map<uint32_t, const Type*> vectorTypeCache;
 
+    // A direct-mapped cache of type relation results, allocated on first use.
+    // Entries are simply overwritten on collision, which keeps the size bounded.
+    // Each entry is guarded by a sequence counter (odd while a write is in progress)
+    // so that concurrent queries never observe a torn entry; see checkTypeRelation.
+    struct TypeRelationEntry {
+        std::atomic<uint32_t> seq = 0;
+        std::atomic<const Type*> lhs = nullptr;
+        std::atomic<const Type*> rhs = nullptr;
+        std::atomic<uint8_t> relationAndResult = 0;
+    };
+    static constexpr size_t TypeRelationCacheSize = 4096;
+    std::atomic<TypeRelationEntry*> typeRelationCache = nullptr;
+    TypeRelationCacheStats typeRelationCacheStats;
+
+    // An index of a scope's named members bucketed by name length, used to
+    // speed up typo correction. Scopes drop their entry whenever their
+    // member list changes.
+    struct TypoIndex {
+        std::vector<std::vector<std::pair<uint32_t, const Symbol*>>> byLength;
+    };
+    flat_hash_map<const Scope*, TypoIndex> typoIndexMap;
+
+    // A cache of candidate symbols for upward hierarchical name lookups,
+    // keyed on the starting scope and name. Only used once finalized.
+    flat_hash_map<std::tuple<const Scope*, std::string_view>, std::span<const Symbol* const>>
+        upwardLookupCache;
+
+    // Caches of interned array types, keyed on element type, range, and
+    // the syntax that declared them.
+    using ArrayTypeKey = std::tuple<const Type*, int32_t, int32_t, const syntax::SyntaxNode*>;
+    flat_hash_map<ArrayTypeKey, const Type*> packedArrayCache;
+    flat_hash_map<ArrayTypeKey, const Type*> unpackedArrayCache;
+
+    // Hashes and compares interned constant values by their exact representation,
+    // i.e. including bit width and signedness for integers.
+    struct ConstantInternHash {
+        size_t operator()(const ConstantValue* cv) const;
+    };
+    struct ConstantInternEqual {
+        bool operator()(const ConstantValue* lhs, const ConstantValue* rhs) const;
+    };
+
+    // The set of interned constant values allocated via allocConstant.
+    flat_hash_set<const ConstantValue*, ConstantInternHash, ConstantInternEqual>
+        internedConstants;
+
+    // The number of bytes saved by reusing values in internedConstants.
+    size_t internedConstantBytesSaved = 0;
+
     // Map from syntax kinds to the built-in types.
     flat_hash_map<syntax::SyntaxKind, const Type*> knownTypes;
 
@@ -870,6 +1021,11 @@ private:
     TypedBumpAllocator<ConfigBlockSymbol> configBlockAllocator;
     TypedBumpAllocator<Scope::WildcardImportData> wildcardImportAllocator;
 
+    // An optional filter for dropping diagnostics as soon as they're created,
+    // along with a count of how many it has dropped.
+    std::function<bool(DiagCode, SourceLocation)> diagFilter;
+    size_t numFilteredDiags = 0;
+
     // This is storage for a temporary diagnostic that is being constructed.
     // Typically this is done in-place within the diagMap, but for diagnostics
     // that have been supressed we need space to return *something* to the caller.
@@ -8,6 +8,8 @@
 #pragma once
 
 #include <map>
+#include <optional>
+#include <vector>
 
 #include "slang/ast/ASTContext.h"
 #include "slang/numeric/ConstantValue.h"
@@ -17,6 +19,7 @@
 namespace slang::ast {
 
 class Compilation;
+class Expression;
 class LValue;
 class SubroutineSymbol;
 class ValueSymbol;
@@ -35,8 +38,15 @@ public:
 
     /// Represents a single frame in the call stack.
     struct Frame {
-        /// A set of temporary values materialized within the stack frame.
-        /// Uses a map so that the values don't move around in memory.
+        /// Storage for the subroutine's local variables, indexed by each variable's
+        /// frame slot. Sized once when the frame is pushed so that the values don't
+        /// move around in memory. Empty entries are locals that haven't been created yet.
+        std::vector<std::optional<ConstantValue>> locals;
+
+        /// A set of temporary values materialized within the stack frame for
+        /// symbols that don't have a frame slot (iterators, pattern variables,
+        /// script-level variables, etc). Uses a map so that the values don't
+        /// move around in memory.
         std::map<const ValueSymbol*, ConstantValue> temporaries;
 
         /// The function that is being executed in this frame, if any.
@@ -155,6 +165,16 @@ public:
     /// Returns nullptr if there is no queue target active.
     const ConstantValue* getQueueTarget() const { return queueTarget; }
 
+    /// Records a result that should be cached in the given expression's
+    /// `constant` pointer once @a applyDeferredCaching is called. Used when
+    /// evaluating with the DeferCaching flag.
+    void deferCaching(const Expression& expr, ConstantValue value);
+
+    /// Applies all results recorded via @a deferCaching to their expressions.
+    /// This must not be called concurrently with any other evaluation that might
+    /// be looking at those expressions.
+    void applyDeferredCaching();
+
     /// Dumps the contents of the call stack to a string for debugging.
     std::string dumpStack() const;
 
@@ -184,6 +204,7 @@ private:
     const ConstantValue* queueTarget = nullptr;
     SmallVector<Frame> stack;
     SmallVector<LValue*> lvalStack;
+    std::vector<std::pair<const Expression*, ConstantValue>> deferredCache;
     Diagnostics diags;
     Diagnostics warnings;
     SourceRange disableRange;
@@ -326,6 +326,14 @@ public:
     static bool findAssertionLocalVar(const ASTContext& context, const syntax::NameSyntax& name,
                                       LookupResult& result);
 
+    /// Gets the symbols that can match the first component of an upward hierarchical
+    /// name lookup of @a name starting in @a scope, in the order in which they should
+    /// be tried. These are scopes and instances with the given name in the scope or any
+    /// of its hierarchical parents, along with any parent instances whose definition
+    /// has the given name.
+    static std::span<const Symbol* const> getUpwardCandidates(const Scope& scope,
+                                                              std::string_view name);
+
 private:
     Lookup() = default;
 
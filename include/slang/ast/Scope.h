@@ -242,6 +242,22 @@ public:
         /// This is mutated as the scope is elaborated.
         SymbolMap importedSymbols;
 
+        /// The result of resolving a name through the wildcard imports.
+        struct ResolvedName {
+            /// The symbol that was found, or nullptr if the name was not found.
+            const Symbol* symbol = nullptr;
+
+            /// The import through which the symbol was found.
+            const WildcardImportSymbol* import = nullptr;
+
+            /// Set if one of the imports referred to a package that doesn't exist.
+            bool suppressUndeclared = false;
+        };
+
+        /// A cache of names resolved through the wildcard imports, keyed on the
+        /// name and the number of imports that were visible from the lookup location.
+        flat_hash_map<std::tuple<std::string_view, size_t>, ResolvedName> resolvedNames;
+
         /// True if we have called forceElaborate on this scope to
         /// ensure that we've seen all imported names.
         bool hasForceElaborated = false;
@@ -313,6 +329,7 @@ private:
 
     DeferredMemberData& getOrAddDeferredData() const;
     void elaborate() const;
+    void invalidateTypoIndex() const;
     void handleNameConflict(const Symbol& member) const;
     void handleNameConflict(const Symbol& member, const Symbol*& existing,
                             bool isElaborating) const;
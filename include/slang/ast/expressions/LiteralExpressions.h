@@ -153,7 +153,7 @@ public:
 class SLANG_EXPORT StringLiteral : public Expression {
 public:
     StringLiteral(const Type& type, std::string_view value, std::string_view rawValue,
-                  ConstantValue& intVal, SourceRange sourceRange);
+                  const ConstantValue& intVal, SourceRange sourceRange);
 
     /// Gets the value of the literal.
     std::string_view getValue() const { return value; }
@@ -176,7 +176,7 @@ public:
 private:
     std::string_view value;
     std::string_view rawValue;
-    ConstantValue* intStorage;
+    const ConstantValue* intStorage;
 };
 
 } // namespace slang::ast
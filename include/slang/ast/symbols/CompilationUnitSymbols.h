@@ -205,12 +205,25 @@ public:
     /// Notes that the definition has been instantiated.
     void noteInstantiated() const { instanceCount++; }
 
+    /// Indicates whether the body of the definition was skipped over at parse time
+    /// and still needs to be parsed before the definition can be instantiated.
+    bool hasDeferredBody() const { return deferredBody; }
+
+    /// Replaces the syntax of a definition whose body was deferred at parse time
+    /// with the fully parsed declaration and recomputes everything derived from it.
+    void setParsedBody(const syntax::ModuleDeclarationSyntax& syntax,
+                       std::optional<TimeScale> directiveTimeScale);
+
     void serializeTo(ASTSerializer& serializer) const;
 
     static bool isKind(SymbolKind kind) { return kind == SymbolKind::Definition; }
 
 private:
+    void initFromSyntax(const Scope& scope, const syntax::ModuleDeclarationSyntax& syntax,
+                        std::optional<TimeScale> directiveTimeScale);
+
     mutable size_t instanceCount = 0;
+    bool deferredBody = false;
 };
 
 /// A rule that controls how a specific cell or instance in the design is configured.
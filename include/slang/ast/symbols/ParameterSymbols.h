@@ -52,6 +52,15 @@ public:
     const ConstantValue& getValue(SourceRange referencingRange = {}) const;
     void setValue(Compilation& compilation, ConstantValue value, bool needsCoercion);
 
+    /// Gets the parameter's initializer if its value has not been evaluated yet and
+    /// the initializer is a self-contained constant expression that doesn't refer to
+    /// any other symbols. Such initializers can be evaluated separately, including
+    /// concurrently with each other, with the result provided via @a setInitializerValue.
+    const Expression* getSelfContainedInitializer() const;
+
+    /// Sets the value of the parameter from the result of evaluating its initializer.
+    void setInitializerValue(ConstantValue value) const;
+
     bool isImplicitString(SourceRange referencingRange) const;
     bool isOverridden() const;
 
@@ -124,6 +133,16 @@ public:
 
     const ConstantValue& getValue(SourceRange referencingRange = {}) const;
 
+    /// Gets the specparam's initializer if its value has not been evaluated yet and
+    /// the initializer is a self-contained constant expression that doesn't refer to
+    /// any other symbols. Such initializers can be evaluated separately, including
+    /// concurrently with each other, with the result provided via @a setInitializerValue.
+    /// PATHPULSE$ specparams are never considered self-contained.
+    const Expression* getSelfContainedInitializer() const;
+
+    /// Sets the value of the specparam from the result of evaluating its initializer.
+    void setInitializerValue(ConstantValue value) const;
+
     const ConstantValue& getPulseRejectLimit() const;
     const ConstantValue& getPulseErrorLimit() const;
 
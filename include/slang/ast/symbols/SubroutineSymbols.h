@@ -122,6 +122,12 @@ public:
     const Statement& getBody() const;
     const Type& getReturnType() const { return declaredReturnType.getType(); }
 
+    /// Gets the set of local variables (including arguments and variables declared
+    /// in nested blocks) that have been assigned dense storage slots for use by
+    /// constant evaluation frames. Slots are assigned when the body is bound.
+    /// Each variable's index in the returned list matches its frame slot.
+    std::span<const VariableSymbol* const> getLocalSlots() const;
+
     void setOverride(const SubroutineSymbol& parentMethod) const;
     const SubroutineSymbol* getOverride() const { return overrides; }
 
@@ -176,6 +182,8 @@ public:
 
 private:
     void addThisVar(const Type& type);
+    static void collectLocalSlots(const Scope& scope,
+                                  SmallVectorBase<const VariableSymbol*>& slots);
 
     std::span<const StatementBlockSymbol* const> blocks;
     mutable const Statement* stmt = nullptr;
@@ -183,6 +191,7 @@ private:
     mutable const SubroutineSymbol* overrides = nullptr;
     mutable const MethodPrototypeSymbol* prototype = nullptr;
     mutable std::optional<bool> cachedHasOutputArgs;
+    mutable std::span<const VariableSymbol* const> localSlots;
     mutable bool isConstructing = false;
 };
 
@@ -59,6 +59,10 @@ public:
 
     void checkInitializer() const;
 
+    /// Gets the index of this variable's storage within the constant evaluation
+    /// frame of its containing subroutine, or UINT32_MAX if it has not been assigned one.
+    uint32_t getFrameSlot() const { return frameSlot; }
+
     void serializeTo(ASTSerializer& serializer) const;
 
     /// Constructs all variable symbols specified by the given syntax node. Note that
@@ -91,6 +95,11 @@ public:
 protected:
     VariableSymbol(SymbolKind childKind, std::string_view name, SourceLocation loc,
                    VariableLifetime lifetime);
+
+private:
+    // Assigned by the containing subroutine when its body is bound.
+    friend class SubroutineSymbol;
+    mutable uint32_t frameSlot = UINT32_MAX;
 };
 
 /// Represents a formal argument in subroutine (task or function).
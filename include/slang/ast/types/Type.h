@@ -39,6 +39,23 @@ enum class SLANG_EXPORT IntegralFlags : uint8_t {
 };
 SLANG_BITMASK(IntegralFlags, Reg)
 
+/// Specifies the relations that can be checked between two types.
+/// See [6.22] for definitions of each.
+enum class SLANG_EXPORT TypeRelation : uint8_t {
+    /// The types are matching (see @a Type::isMatching).
+    Matching,
+
+    /// The types are equivalent (see @a Type::isEquivalent).
+    Equivalent,
+
+    /// The rhs type is assignment compatible to the lhs
+    /// (see @a Type::isAssignmentCompatible).
+    AssignmentCompatible,
+
+    /// The rhs type is cast compatible to the lhs (see @a Type::isCastCompatible).
+    CastCompatible
+};
+
 /// @brief Base class for all data types in SystemVerilog.
 ///
 /// Note that this can actually be an alias for some other type (such as with typedefs or
@@ -154,6 +154,12 @@ public:
     /// to an error.
     std::error_code addIgnoreMacroPaths(std::string_view pattern);
 
+    /// Returns true if a diagnostic with the given code issued at the given location
+    /// is known to be dropped by this engine, either because its severity maps to
+    /// Ignored or because it's a warning located in one of the ignored paths.
+    /// This can be used to filter out diagnostics before they are fully constructed.
+    bool isSuppressed(DiagCode code, SourceLocation location);
+
     /// Sets a custom formatter function for the given type. This is used to
     /// provide formatting for diagnostic arguments of a custom type.
     template<typename ForType>
@@ -263,6 +269,9 @@ private:
     std::vector<std::filesystem::path> ignoreWarnPatterns;
     std::vector<std::filesystem::path> ignoreMacroWarnPatterns;
 
+    // A cache of whether each buffer matches one of the ignoreWarnPatterns.
+    flat_hash_map<BufferID, bool> ignoredBufferCache;
+
     // A list of all registered clients that receive issued diagnostics.
     std::vector<std::shared_ptr<DiagnosticClient>> clients;
 
@@ -190,7 +190,9 @@ public:
     Diagnostic& add(const ast::Symbol& source, DiagCode code, SourceRange range);
 
     /// Sorts the diagnostics in the collection based on source file and line number.
-    void sort(const SourceManager& sourceManager);
+    /// If @a numThreads is not 1, large collections are sorted using that many
+    /// threads (zero means the number of hardware threads).
+    void sort(const SourceManager& sourceManager, uint32_t numThreads = 1);
 
     /// Returns a copy of this collection with all diagnostics that match any of
     /// the codes given in @a list filtered out.
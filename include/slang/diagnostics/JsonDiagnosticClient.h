@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+//! @file JsonDiagnosticClient.h
+//! @brief Diagnostic client that formats to JSON Lines records
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "slang/diagnostics/DiagnosticClient.h"
+#include "slang/util/Hash.h"
+
+namespace slang {
+
+class JsonWriter;
+
+namespace ast {
+class Symbol;
+}
+
+/// A diagnostic client that writes one compact JSON object per line for each
+/// reported diagnostic, intended for consumption by external tools.
+///
+/// File names are not repeated in each diagnostic record; instead, the first
+/// time a file is referenced a record of the form {"file":<id>,"name":<path>}
+/// is written, and diagnostic records refer to the file by that id.
+class SLANG_EXPORT JsonDiagnosticClient : public DiagnosticClient {
+public:
+    JsonDiagnosticClient();
+    ~JsonDiagnosticClient();
+
+    template<typename TFunc>
+    void setSymbolPathCB(TFunc&& func) {
+        symbolPathCB = std::forward<TFunc>(func);
+    }
+
+    template<typename TFunc>
+    static void setDefaultSymbolPathCB(TFunc&& func) {
+        defaultSymbolPathCB = std::forward<TFunc>(func);
+    }
+
+    /// Sets a callback that receives records as they are produced, instead of
+    /// accumulating all of them for a later call to @a getString.
+    /// Text is handed off in chunks of roughly @a flushThreshold bytes.
+    template<typename TFunc>
+    void setOutputSink(TFunc&& func, size_t flushThreshold = 64 * 1024) {
+        outputSink = std::forward<TFunc>(func);
+        sinkThreshold = flushThreshold;
+    }
+
+    /// Passes any buffered text to the output sink, if one has been set.
+    void flush();
+
+    void report(const ReportedDiagnostic& diagnostic) override;
+
+    void clear();
+    std::string getString() const;
+
+private:
+    uint32_t getFileId(SourceLocation loc);
+
+    std::unique_ptr<JsonWriter> writer;
+    std::string buffer;
+    flat_hash_map<std::string_view, uint32_t> fileIds;
+
+    using SymbolPathCB = std::function<std::string(const ast::Symbol&)>;
+    SymbolPathCB symbolPathCB;
+    static SymbolPathCB defaultSymbolPathCB;
+
+    using OutputSinkCB = std::function<void(std::string_view)>;
+    OutputSinkCB outputSink;
+    size_t sinkThreshold = 0;
+};
+
+} // namespace slang
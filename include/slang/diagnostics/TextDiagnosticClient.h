@@ -16,6 +16,7 @@
 namespace slang {
 
 class FormatBuffer;
+struct SourceSnippet;
 
 namespace ast {
 class Symbol;
@@ -55,6 +56,19 @@ public:
         defaultSymbolPathCB = std::forward<TFunc>(func);
     }
 
+    /// Sets a callback that receives formatted diagnostic text as it is produced,
+    /// instead of accumulating all of it for a later call to @a getString.
+    /// Text is handed off in chunks of roughly @a flushThreshold bytes, so memory
+    /// use stays flat regardless of the number of diagnostics reported.
+    template<typename TFunc>
+    void setOutputSink(TFunc&& func, size_t flushThreshold = 64 * 1024) {
+        outputSink = std::forward<TFunc>(func);
+        sinkThreshold = flushThreshold;
+    }
+
+    /// Passes any buffered text to the output sink, if one has been set.
+    void flush();
+
     fmt::terminal_color getSeverityColor(DiagnosticSeverity severity) const;
 
     void report(const ReportedDiagnostic& diagnostic) override;
@@ -64,6 +78,7 @@ public:
 
 private:
     std::unique_ptr<FormatBuffer> buffer;
+    std::unique_ptr<SourceSnippet> snippet;
     bool includeColumn = true;
     bool includeLocation = true;
     bool includeSource = true;
@@ -76,6 +91,10 @@ private:
     SymbolPathCB symbolPathCB;
     static SymbolPathCB defaultSymbolPathCB;
 
+    using OutputSinkCB = std::function<void(std::string_view)>;
+    OutputSinkCB outputSink;
+    size_t sinkThreshold = 0;
+
     void formatDiag(SourceLocation loc, std::span<const SourceRange> ranges,
                     DiagnosticSeverity severity, std::string_view message,
                     std::string_view optionName);
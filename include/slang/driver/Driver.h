@@ -18,6 +18,7 @@
 #include "slang/util/Util.h"
 
 namespace slang {
+class JsonDiagnosticClient;
 class TextDiagnosticClient;
 }
 
@@ -69,6 +70,10 @@ public:
     /// The diagnostics client that will be used to render diagnostics.
     std::shared_ptr<TextDiagnosticClient> diagClient;
 
+    /// An optional client that writes diagnostics as JSON Lines records,
+    /// created if the diagJson option is set.
+    std::shared_ptr<JsonDiagnosticClient> jsonDiagClient;
+
     /// The object that handles loading and parsing source files.
     SourceLoader sourceLoader;
 
@@ -99,6 +104,10 @@ public:
         /// If true, library files will inherit macro definitions from primary source files.
         std::optional<bool> librariesInheritMacros;
 
+        /// If true, the bodies of definitions in library files are only parsed
+        /// once they are actually used in the design.
+        std::optional<bool> deferLibraryBodies;
+
         /// If true, the preprocessor will support legacy protected envelope directives,
         /// for compatibility with old Verilog tools.
         std::optional<bool> enableLegacyProtect;
@@ -116,7 +125,7 @@ public:
         /// The maximum number of lexer errors that can be encountered before giving up.
         std::optional<uint32_t> maxLexerErrors;
 
-        /// The number of threads to use for parsing.
+        /// The number of threads to use for parsing and elaboration.
         std::optional<uint32_t> numThreads;
 
         /// @}
@@ -206,6 +215,10 @@ public:
         /// include hierarchy paths in printed diagnostics.
         std::optional<std::string> diagHierarchy;
 
+        /// If set, the path of a file to which diagnostics will additionally be
+        /// written in JSON Lines format ("-" for stdout).
+        std::optional<std::string> diagJson;
+
         /// The maximum number of errors to print before giving up.
         std::optional<uint32_t> errorLimit;
 
@@ -318,6 +331,7 @@ private:
     void addLibraryFiles(std::string_view pattern);
     void addParseOptions(Bag& bag) const;
     void addCompilationOptions(Bag& bag) const;
+    uint32_t getNumThreads() const;
     bool reportLoadErrors();
     void printError(const std::string& message);
     void printWarning(const std::string& message);
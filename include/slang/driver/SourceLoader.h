@@ -49,6 +49,10 @@ struct SLANG_EXPORT SourceOptions {
 
     /// If true, library files will inherit macro definitions from primary source files.
     bool librariesInheritMacros;
+
+    /// If true, the bodies of modules, interfaces, and programs in library files
+    /// are skipped over at parse time and only parsed once they are actually used.
+    bool deferLibraryBodies;
 };
 
 /// @brief Handles loading and parsing of groups of source files
@@ -209,7 +213,8 @@ private:
     void createLibrary(const syntax::LibraryDeclarationSyntax& syntax,
                        const std::filesystem::path& basePath);
     LoadResult loadAndParse(const FileEntry& fileEntry, const Bag& optionBag,
-                            const SourceOptions& srcOptions, uint64_t fileSortKey = UINT64_MAX);
+                            const Bag& libraryOptionBag, const SourceOptions& srcOptions,
+                            uint64_t fileSortKey = UINT64_MAX);
     void addError(const std::filesystem::path& path, std::error_code ec);
 
     SourceManager& sourceManager;
@@ -15,6 +15,7 @@
 
 #include "slang/numeric/SVInt.h"
 #include "slang/util/CopyPtr.h"
+#include "slang/util/CowPtr.h"
 #include "slang/util/Iterator.h"
 
 namespace slang {
@@ -58,12 +59,17 @@ public:
     struct UnboundedPlaceholder : std::monostate {};
 
     using Elements = std::vector<ConstantValue>;
-    using Map = CopyPtr<AssociativeArray>;
-    using Queue = CopyPtr<SVQueue>;
+
+    // Unpacked arrays, associative arrays, and queues can be very large, so their
+    // storage is shared between copies until one of them is modified.
+    using ElementsPtr = CowPtr<Elements>;
+    using Map = CowPtr<AssociativeArray>;
+    using Queue = CowPtr<SVQueue>;
     using Union = CopyPtr<SVUnion>;
 
     using Variant = std::variant<std::monostate, SVInt, real_t, shortreal_t, NullPlaceholder,
-                                 Elements, std::string, Map, Queue, Union, UnboundedPlaceholder>;
+                                 ElementsPtr, std::string, Map, Queue, Union,
+                                 UnboundedPlaceholder>;
 
     ConstantValue() = default;
     ConstantValue(nullptr_t) {}
@@ -75,8 +81,8 @@ public:
 
     ConstantValue(NullPlaceholder nul) : value(nul) {}
     ConstantValue(UnboundedPlaceholder unbounded) : value(unbounded) {}
-    ConstantValue(const Elements& elements) : value(elements) {}
-    ConstantValue(Elements&& elements) : value(std::move(elements)) {}
+    ConstantValue(const Elements& elements) : value(ElementsPtr(elements)) {}
+    ConstantValue(Elements&& elements) : value(ElementsPtr(std::move(elements))) {}
     ConstantValue(const std::string& str) : value(str) {}
     ConstantValue(std::string&& str) : value(std::move(str)) {}
 
@@ -103,7 +109,7 @@ public:
     bool isShortReal() const { return std::holds_alternative<shortreal_t>(value); }
     bool isNullHandle() const { return std::holds_alternative<NullPlaceholder>(value); }
     bool isUnbounded() const { return std::holds_alternative<UnboundedPlaceholder>(value); }
-    bool isUnpacked() const { return std::holds_alternative<Elements>(value); }
+    bool isUnpacked() const { return std::holds_alternative<ElementsPtr>(value); }
     bool isString() const { return std::holds_alternative<std::string>(value); }
     bool isMap() const { return std::holds_alternative<Map>(value); }
     bool isQueue() const { return std::holds_alternative<Queue>(value); }
@@ -119,8 +125,8 @@ public:
     real_t real() const { return std::get<real_t>(value); }
     shortreal_t shortReal() const { return std::get<shortreal_t>(value); }
 
-    std::span<ConstantValue> elements() { return std::get<Elements>(value); }
-    std::span<ConstantValue const> elements() const { return std::get<Elements>(value); }
+    std::span<ConstantValue> elements() { return *std::get<ElementsPtr>(value); }
+    std::span<ConstantValue const> elements() const { return *std::get<ElementsPtr>(value); }
 
     std::string& str() & { return std::get<std::string>(value); }
     const std::string& str() const& { return std::get<std::string>(value); }
@@ -267,11 +273,9 @@ CVIterator<IsConst> begin(TValue& cv) {
     return std::visit(
         [](auto&& arg) -> CVIterator<IsConst> {
             using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, ConstantValue::Elements>) {
-                return arg.begin();
-            }
-            else if constexpr (std::is_same_v<T, ConstantValue::Map> ||
-                               std::is_same_v<T, ConstantValue::Queue>) {
+            if constexpr (std::is_same_v<T, ConstantValue::ElementsPtr> ||
+                          std::is_same_v<T, ConstantValue::Map> ||
+                          std::is_same_v<T, ConstantValue::Queue>) {
                 return arg->begin();
             }
             else {
@@ -287,11 +291,9 @@ CVIterator<IsConst> end(TValue& cv) {
     return std::visit(
         [](auto&& arg) -> CVIterator<IsConst> {
             using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, ConstantValue::Elements>) {
-                return arg.end();
-            }
-            else if constexpr (std::is_same_v<T, ConstantValue::Map> ||
-                               std::is_same_v<T, ConstantValue::Queue>) {
+            if constexpr (std::is_same_v<T, ConstantValue::ElementsPtr> ||
+                          std::is_same_v<T, ConstantValue::Map> ||
+                          std::is_same_v<T, ConstantValue::Queue>) {
                 return arg->end();
             }
             else {
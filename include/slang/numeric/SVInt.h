@@ -610,6 +610,16 @@ private:
 
     static SVInt fromDecimalDigits(bitwidth_t bits, bool isSigned, std::span<logic_t const> digits);
 
+    // Divide-and-conquer decimal conversion for long digit strings; splits the digits
+    // around powers of ten from the given table and recombines the halves.
+    static SVInt fromDecimalDigitsSplit(std::span<logic_t const> digits,
+                                        std::span<const SVInt> powers);
+
+    // Writes the decimal digits of this (known, non-negative) value into the buffer in
+    // reverse order, zero padding to at least minDigits.
+    void writeDecimalDigits(SmallVectorBase<char>& buffer, size_t minDigits,
+                            std::span<const SVInt> powers) const;
+
     static SVInt fromPow2Digits(bitwidth_t bits, bool isSigned, bool anyUnknown, uint32_t radix,
                                 uint32_t shift, std::span<logic_t const> digits);
 
@@ -51,6 +51,12 @@ public:
     Lexer(SourceBuffer buffer, BumpAllocator& alloc, Diagnostics& diagnostics,
           LexerOptions options = LexerOptions{});
 
+    /// Constructs a lexer that begins lexing @a startOffset bytes into the given
+    /// buffer instead of at its start. Token locations are still relative to the
+    /// start of the buffer. The offset should point at the start of a token.
+    Lexer(SourceBuffer buffer, size_t startOffset, BumpAllocator& alloc,
+          Diagnostics& diagnostics, LexerOptions options = LexerOptions{});
+
     // Not copyable
     Lexer(const Lexer&) = delete;
     Lexer& operator=(const Lexer&) = delete;
@@ -132,6 +132,13 @@ struct SLANG_EXPORT ParserOptions {
 
     /// The version of the SystemVerilog language to use.
     LanguageVersion languageVersion = LanguageVersion::Default;
+
+    /// If true, the bodies of top-level module, interface, and program declarations
+    /// are skipped over instead of being parsed, to be parsed later on demand via
+    /// @a SyntaxTree::parseDeferredBody. Declarations that involve the preprocessor
+    /// in any way are always parsed in full. The skipped declarations are recorded
+    /// in the @a ParserMetadata::deferredBodies set.
+    bool deferModuleBodies = false;
 };
 
 /// Implements a full syntax parser for SystemVerilog.
@@ -153,6 +160,7 @@ public:
     syntax::MemberSyntax& parseModule();
     syntax::ClassDeclarationSyntax& parseClass();
     syntax::MemberSyntax* parseSingleMember(syntax::SyntaxKind parentKind);
+    syntax::MemberSyntax* parseSingleClassMember(bool isIfaceClass, bool hasBaseClass);
     syntax::NameSyntax& parseName();
 
     /// Generalized node parse function that tries to figure out what we're
@@ -247,6 +255,8 @@ private:
     syntax::ModuleHeaderSyntax& parseModuleHeader();
     syntax::ParameterPortListSyntax* parseParameterPortList();
     syntax::MemberSyntax& parseModule(AttrList attributes, syntax::SyntaxKind parentKind, bool& anyLocalModules);
+    uint32_t scanDeferrableBody(TokenKind endKind, AttrList attributes,
+                                const syntax::ModuleHeaderSyntax& header);
     syntax::AnonymousProgramSyntax& parseAnonymousProgram(AttrList attributes);
     syntax::MemberSyntax& parseModportSubroutinePortList(AttrList attributes);
     syntax::MemberSyntax& parseModportPort();
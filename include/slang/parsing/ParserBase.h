@@ -36,6 +36,7 @@ protected:
     Token consumeIf(TokenKind kind);
     Token expect(TokenKind kind);
     void skipToken(std::optional<DiagCode> diagCode);
+    void skipTokens(uint32_t count);
     void pushTokens(std::span<const Token> tokens);
 
     Token missingToken(TokenKind kind, SourceLocation location);
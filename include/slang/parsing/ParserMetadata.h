@@ -47,6 +47,10 @@ struct SLANG_EXPORT ParserMetadata {
     /// A list of all interface port headers parsed.
     std::vector<const syntax::InterfacePortHeaderSyntax*> interfacePorts;
 
+    /// A set of module, interface, and program declarations whose bodies were
+    /// skipped over at parse time and still need to be parsed on demand.
+    flat_hash_set<const syntax::ModuleDeclarationSyntax*> deferredBodies;
+
     /// The EOF token, if one has already been consumed by the parser.
     /// Otherwise an empty token.
     Token eofToken;
@@ -77,6 +77,11 @@ public:
     void pushSource(std::string_view source, std::string_view name = "source");
     void pushSource(SourceBuffer buffer);
 
+    /// Push a new source file onto the stack, starting at the given byte offset
+    /// within the buffer instead of at its beginning. This is used to re-lex a
+    /// region of a buffer whose earlier contents have already been processed.
+    void pushSource(SourceBuffer buffer, size_t startOffset);
+
     /// Predefines the given macro definition. The given definition string is lexed
     /// as if it were source text immediately following a `define directive.
     /// If any diagnostics are printed for the created text, they will be marked
@@ -147,6 +152,10 @@ public:
     /// Gets all macros that have been defined thus far in the preprocessor.
     std::vector<const syntax::DefineDirectiveSyntax*> getDefinedMacros() const;
 
+    /// Gets the number of top-level macro usages whose expansion was reused
+    /// from an earlier usage with identical text.
+    size_t getNumReusedExpansions() const { return numReusedExpansions; }
+
 private:
     Preprocessor(const Preprocessor& other);
     Preprocessor& operator=(const Preprocessor& other) = delete;
@@ -290,8 +299,29 @@ private:
         bool isTopLevel = false;
     };
 
+    // A fully expanded top-level macro usage, saved so that later usages of the
+    // same macro with identical argument text can skip expansion entirely.
+    // Along with the tokens we keep the macro expansion locations they reference,
+    // in creation order, so that fresh ones can be created for each new usage.
+    struct CachedExpansion {
+        struct ExpansionLoc {
+            BufferID buffer;
+            SourceLocation originalLoc;
+            SourceRange expansionRange;
+            std::string_view macroName;
+            bool isMacroArg;
+        };
+
+        std::span<const Token> tokens;
+        std::span<const ExpansionLoc> expansionLocs;
+        SourceRange usageRange;
+    };
+
     // Macro handling methods
     MacroDef findMacro(Token directive);
+    void cacheExpansion(std::string&& key, SourceRange usageRange);
+    void clearExpansionCache();
+    void reuseExpansion(const CachedExpansion& cached, SourceRange usageRange);
     std::pair<syntax::MacroActualArgumentListSyntax*, Trivia> handleTopLevelMacro(Token directive);
     bool expandMacro(MacroDef macro, MacroExpansion& expansion,
                      syntax::MacroActualArgumentListSyntax* actualArgs);
@@ -390,6 +420,21 @@ private:
     // map from macro name to macro definition
     flat_hash_map<std::string_view, MacroDef> macros;
 
+    // cache of expanded top-level macro usages, keyed by the text of the usage;
+    // cleared whenever any macro is defined or undefined
+    flat_hash_map<std::string, CachedExpansion> expansionCache;
+
+    // text of usages that have been expanded once since the cache was last
+    // cleared; only usages seen a second time get their expansion cached
+    flat_hash_set<std::string> seenExpansions;
+
+    // the number of usages that reused a cached expansion
+    size_t numReusedExpansions = 0;
+
+    // set when an intrinsic macro like `__LINE__ is expanded, since the
+    // results of those depend on where they are used
+    bool expandedIntrinsic = false;
+
     // list of expanded macro tokens to drain before continuing with active lexer
     SmallVector<Token> expandedTokens;
     Token* currentMacroToken = nullptr;
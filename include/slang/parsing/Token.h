@@ -202,8 +202,19 @@ private:
     void init(BumpAllocator& alloc, TokenKind kind, std::span<Trivia const> trivia,
               std::string_view rawText, SourceLocation location);
 
+    // Gets the start of the kind-specific data in the info block, which follows
+    // the raw text pointer if the token stores one.
+    byte* extra() const;
+
+    template<typename T>
+    T& extraAs() const {
+        return *reinterpret_cast<T*>(extra());
+    }
+
     // Some data is stored directly in the token here because we have 6 bytes of padding that
-    // would otherwise go unused. The rest is stored in the info block.
+    // would otherwise go unused. The rest is stored in the info block. rawLen is zero
+    // for tokens whose text is implied by their kind, in which case the info block
+    // has no raw text pointer at all.
     bool missing : 1;
     uint8_t triviaCountSmall : 4;
     uint8_t reserved : 3;
@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include "slang/parsing/Token.h"
@@ -96,7 +97,39 @@ public:
         return *this;
     }
 
-    /// @return a copy of the internal text buffer.
+    /// Sets a callback that receives printed text as it is produced, instead of
+    /// accumulating all of it in the internal buffer. Text is handed off in chunks
+    /// of roughly @a flushThreshold bytes, so memory use stays bounded no matter
+    /// how much is printed. Pass nullptr to go back to buffering everything.
+    template<typename TFunc>
+    SyntaxPrinter& setOutputSink(TFunc&& func, size_t flushThreshold = 64 * 1024) {
+        outputSink = std::forward<TFunc>(func);
+        sinkThreshold = flushThreshold;
+        sliceMode = false;
+        return *this;
+    }
+
+    /// Sets a callback that receives printed text as slices that point directly at
+    /// the text of the printed tokens and trivia, without copying any of it into the
+    /// internal buffer. Slices that are adjacent in memory, such as unmodified runs
+    /// of the original source buffer, are merged before being handed off, so printing
+    /// an unchanged file produces a few large slices. Each slice is only guaranteed to
+    /// remain valid for the duration of the call; call flush() once printing is done
+    /// to hand off the final slice.
+    template<typename TFunc>
+    SyntaxPrinter& setSliceSink(TFunc&& func) {
+        outputSink = std::forward<TFunc>(func);
+        sinkThreshold = 0;
+        sliceMode = true;
+        return *this;
+    }
+
+    /// Passes any buffered text to the output sink, if one has been set.
+    /// @return a reference to this object, to allow chaining additional method calls.
+    SyntaxPrinter& flush();
+
+    /// @return a copy of the internal text buffer. If an output sink is set this
+    /// only contains text that has not yet been flushed.
     std::string str() const { return buffer; }
 
     /// A helper method that assists in printing an entire syntax tree back to source
@@ -104,9 +137,31 @@ public:
     /// and the resulting text is returned.
     static std::string printFile(const SyntaxTree& tree);
 
+    /// Prints an entire syntax tree back to source text using the same defaults as
+    /// the overload above, but hands the text to @a sink as slices (see setSliceSink)
+    /// instead of building up a string, so unmodified source text is never copied.
+    static void printFile(const SyntaxTree& tree,
+                          const std::function<void(std::string_view)>& sink);
+
 private:
+    void write(std::string_view text, bool stable);
+    void appendText(std::string_view text, bool stable);
+    std::string_view getSourceSlice(parsing::Token token);
+
     std::string buffer;
     const SourceManager* sourceManager = nullptr;
+    std::function<void(std::string_view)> outputSink;
+    size_t sinkThreshold = 0;
+
+    // In slice mode, the text that has been printed but not yet handed off.
+    std::string_view pendingSlice;
+
+    // The source buffer most recently used to find token text in slice mode.
+    BufferID sliceBuffer;
+    std::string_view sliceBufferText;
+
+    bool lastNewline = false;
+    bool sliceMode = false;
     bool includeTrivia = true;
     bool includeMissing = false;
     bool includeSkipped = false;
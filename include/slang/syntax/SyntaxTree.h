@@ -30,13 +30,14 @@ namespace slang::syntax {
 
 class SyntaxNode;
 struct DefineDirectiveSyntax;
+struct ModuleDeclarationSyntax;
 
 /// The SyntaxTree is the easiest way to interface with the lexer / preprocessor /
 /// parser stack. Give it some source text and it produces a parse tree.
 ///
 /// The SyntaxTree object owns all of the memory for the parse tree, so it must
 /// live for as long as you need to access its syntax nodes.
-class SLANG_EXPORT SyntaxTree {
+class SLANG_EXPORT SyntaxTree : public std::enable_shared_from_this<SyntaxTree> {
 public:
     using TreeOrError =
         nonstd::expected<std::shared_ptr<SyntaxTree>, std::pair<std::error_code, std::string_view>>;
@@ -149,6 +150,26 @@ public:
                                                    const Bag& options = {},
                                                    MacroList inheritedMacros = {});
 
+    /// Creates a new syntax tree by applying a text edit to an existing one.
+    /// @a oldTree is the previously parsed tree whose source text is being edited.
+    /// @a offset is the byte offset of the edit within the old source text.
+    /// @a length is the number of bytes of old text being replaced.
+    /// @a newText is the text that replaces the old range.
+    /// @a name is an optional name to give to the new source buffer.
+    /// @a path is an optional path to give to the new source buffer.
+    ///
+    /// When the edit falls strictly inside a single member (a module or package
+    /// item, a class item, or a statement in a block) and cannot affect preprocessor
+    /// state, only that member is re-lexed and re-parsed and the rest of the tree is
+    /// shared with @a oldTree, which is kept alive by the new tree. This requires
+    /// @a oldTree to be owned by a shared_ptr. Otherwise the whole edited text is
+    /// parsed again.
+    /// @return the created and parsed syntax tree.
+    static std::shared_ptr<SyntaxTree> fromTextEdit(const SyntaxTree& oldTree, size_t offset,
+                                                    size_t length, std::string_view newText,
+                                                    std::string_view name = "source"sv,
+                                                    std::string_view path = "");
+
     /// Creates a syntax tree from a library map file.
     /// @a path is the path to the source file on disk.
     /// @a sourceManager is the manager that owns all of the loaded source code.
@@ -210,6 +231,16 @@ public:
     /// Gets the list of macros that were defined at the end of the loaded source file.
     MacroList getDefinedMacros() const { return macros; }
 
+    /// Parses the full text of a module, interface, or program declaration whose
+    /// body was skipped over when this tree was parsed (see
+    /// @a ParserOptions::deferModuleBodies). The new syntax nodes are allocated
+    /// from @a alloc and any diagnostics issued are added to @a diagnostics.
+    /// @return the fully parsed declaration, or nullptr if @a syntax does not
+    /// have a deferred body.
+    const ModuleDeclarationSyntax* parseDeferredBody(const ModuleDeclarationSyntax& syntax,
+                                                     BumpAllocator& alloc,
+                                                     Diagnostics& diagnostics) const;
+
     /// This is a shared default source manager for cases where the user doesn't
     /// care about managing the lifetime of loaded source. Note that all of
     /// the source loaded by this thing will live in memory for the lifetime of
@@ -226,6 +257,10 @@ private:
                                               const Bag& options, MacroList inheritedMacros,
                                               bool guess);
 
+    static std::shared_ptr<SyntaxTree> reparseEdit(const SyntaxTree& oldTree,
+                                                   const SourceBuffer& buffer, size_t offset,
+                                                   size_t length, std::string_view newText);
+
     SyntaxNode* rootNode;
     const SourceLibrary* library;
     SourceManager& sourceMan;
@@ -234,6 +269,12 @@ private:
     Bag options_;
     std::unique_ptr<parsing::ParserMetadata> metadata;
     std::vector<const DefineDirectiveSyntax*> macros;
+
+    // Set on trees created by a text edit that share syntax nodes with the tree
+    // they were derived from: that tree, which owns the shared nodes, and the
+    // buffers that tokens in the tree can point into.
+    std::shared_ptr<const SyntaxTree> baseTree;
+    std::vector<BufferID> editBuffers;
 };
 
 } // namespace slang::syntax
@@ -12,6 +12,8 @@
 #include "slang/syntax/AllSyntax.h"
 #include "slang/syntax/SyntaxTree.h"
 #include "slang/util/Hash.h"
+#include "slang/util/SmallVector.h"
+#include "slang/util/ThreadPool.h"
 #include "slang/util/TypeTraits.h"
 
 namespace slang::syntax {
@@ -21,7 +23,17 @@ namespace slang::syntax {
 /// Use this type as a base class for syntax tree visitors. It will default to
 /// traversing all children of each node. Add implementations for any specific
 /// node types you want to handle.
-template<typename TDerived>
+///
+/// If @a ExplicitStack is true, visitDefault walks the subtree using a heap
+/// allocated work list instead of recursing through each child. Handlers are
+/// still invoked in the same order, and code in a handler that runs after its
+/// call to visitDefault still sees the entire subtree as visited. Only nodes
+/// that have a handler cost a native stack frame, so extremely deep chains of
+/// unhandled nodes (e.g. long machine-generated expressions) can be visited
+/// without overflowing the stack. Derived classes that hide visit() or
+/// visitDefault() should not use this mode, since nodes popped off of the
+/// work list are dispatched to their handlers directly.
+template<typename TDerived, bool ExplicitStack = false>
 class SyntaxVisitor {
 public:
     /// Visit the provided node, of static type T.
@@ -37,14 +49,33 @@ public:
     /// Will visit all child nodes by default.
     template<typename T>
     void visitDefault(T&& node) {
-        for (uint32_t i = 0; i < node.getChildCount(); i++) {
-            auto child = node.childNode(i);
-            if (child)
-                child->visit(*DERIVED);
-            else {
-                auto token = node.childToken(i);
-                if (token)
-                    DERIVED->visitToken(token);
+        if constexpr (ExplicitStack) {
+            using TNode = std::conditional_t<std::is_const_v<std::remove_reference_t<T>>,
+                                             const SyntaxNode, SyntaxNode>;
+            SmallVector<StackEntry<TNode>> stack;
+            pushChildren(node, stack);
+
+            Expander<TNode> expander{*DERIVED, stack};
+            while (!stack.empty()) {
+                auto entry = stack.back();
+                stack.pop_back();
+
+                if (entry.node)
+                    entry.node->visit(expander);
+                else
+                    DERIVED->visitToken(entry.token);
+            }
+        }
+        else {
+            for (uint32_t i = 0; i < node.getChildCount(); i++) {
+                auto child = node.childNode(i);
+                if (child)
+                    child->visit(*DERIVED);
+                else {
+                    auto token = node.childToken(i);
+                    if (token)
+                        DERIVED->visitToken(token);
+                }
             }
         }
     }
@@ -52,6 +83,41 @@ public:
 private:
     // This is to make things compile if the derived class doesn't provide an implementation.
     void visitToken(parsing::Token) {}
+
+    // A pending child in explicit stack mode; either a node or a token.
+    template<typename TNode>
+    struct StackEntry {
+        TNode* node;
+        parsing::Token token;
+    };
+
+    // Pushes the children of the given node in reverse so that
+    // they get popped back off in their original order.
+    template<typename T, typename TNode>
+    static void pushChildren(T& node, SmallVectorBase<StackEntry<TNode>>& stack) {
+        for (size_t i = node.getChildCount(); i > 0; i--) {
+            if (auto child = node.childNode(i - 1))
+                stack.push_back({child, {}});
+            else if (auto token = node.childToken(i - 1))
+                stack.push_back({nullptr, token});
+        }
+    }
+
+    // Dispatches popped nodes to their handler if the derived class has one,
+    // or otherwise pushes their children onto the stack in place of recursing.
+    template<typename TNode>
+    struct Expander {
+        TDerived& derived;
+        SmallVectorBase<StackEntry<TNode>>& stack;
+
+        template<typename T>
+        void visit(T& node) {
+            if constexpr (requires { derived.handle(node); })
+                derived.handle(node);
+            else
+                pushChildren(node, stack);
+        }
+    };
 };
 
 namespace detail {
@@ -88,6 +154,10 @@ struct SLANG_EXPORT ChangeCollection {
         return insertBefore.empty() && insertAfter.empty() && removeOrReplace.empty() &&
                listInsertAtFront.empty() && listInsertAtBack.empty();
     }
+
+    /// Moves all changes from @a other into this collection. Changes for the same
+    /// node are kept in order, with those from @a other coming after existing ones.
+    void merge(ChangeCollection&& other);
 };
 
 SLANG_EXPORT std::shared_ptr<SyntaxTree> transformTree(
@@ -127,6 +197,97 @@ public:
         return transformTree(std::move(alloc), tree, commits, tempTrees, library);
     }
 
+    /// Transforms the given syntax tree like transform(), except that the top-level
+    /// members of the compilation unit are visited concurrently on @a numThreads
+    /// threads (or one per hardware thread if zero).
+    ///
+    /// Each thread visits a contiguous run of members using its own rewriter, created
+    /// by calling @a makeRewriter, so handlers don't share any state or allocators.
+    /// Requested changes are merged in member order afterward, so the result is the
+    /// same as visiting the whole tree with a single rewriter as long as handlers
+    /// don't depend on what they saw in earlier members.
+    ///
+    /// If the root of the tree is not a compilation unit, or the rewriter has a
+    /// handler for the compilation unit or its member list (either as a generic
+    /// SyntaxListBase or as the typed member list), this falls back to a serial
+    /// transform.
+    ///
+    /// Exceptions thrown by handlers, along with conflicting remove or replace
+    /// requests from different chunks, are rethrown once all chunks have finished.
+    template<typename TFactory>
+    static std::shared_ptr<SyntaxTree> transformParallel(const std::shared_ptr<SyntaxTree>& tree,
+                                                         TFactory&& makeRewriter,
+                                                         unsigned numThreads = 0,
+                                                         const SourceLibrary* library = nullptr) {
+        TDerived mainRewriter = makeRewriter();
+        SyntaxRewriter& main = mainRewriter;
+
+        auto& root = tree->root();
+        if (root.kind != SyntaxKind::CompilationUnit ||
+            requires(const CompilationUnitSyntax& cu) { mainRewriter.handle(cu); } ||
+            requires(const SyntaxListBase& list) { mainRewriter.handle(list); } ||
+            requires(const SyntaxList<MemberSyntax>& list) { mainRewriter.handle(list); }) {
+            return main.transform(tree, library);
+        }
+
+        auto& unit = root.as<CompilationUnitSyntax>();
+        auto& members = unit.members;
+        main.sourceManager = &tree->sourceManager();
+        main.commits.clear();
+        main.tempTrees.clear();
+
+        struct ChunkResult {
+            BumpAllocator alloc;
+            detail::ChangeCollection commits;
+            std::vector<std::shared_ptr<SyntaxTree>> tempTrees;
+        };
+
+        // The results must outlive the pool, whose destructor waits for any
+        // chunks still running if merging throws partway through.
+        std::vector<ChunkResult> results;
+        std::vector<std::future<void>> futures;
+        ThreadPool threadPool(numThreads);
+        const size_t numChunks = std::min(threadPool.getThreadCount(), members.size());
+        results.resize(numChunks);
+        for (size_t i = 0; i < numChunks; i++) {
+            futures.push_back(threadPool.submit([&, i] {
+                TDerived chunkRewriter = makeRewriter();
+                SyntaxRewriter& chunk = chunkRewriter;
+                chunk.sourceManager = main.sourceManager;
+
+                const size_t end = (i + 1) * members.size() / numChunks;
+                for (size_t j = i * members.size() / numChunks; j < end; j++)
+                    members[j]->visit(chunkRewriter);
+
+                auto& result = results[i];
+                result.alloc = std::move(chunk.alloc);
+                result.commits = std::move(chunk.commits);
+                result.tempTrees = std::move(chunk.tempTrees);
+            }));
+        }
+
+        // Merge in chunk order so that changes made to the same node by
+        // different chunks end up in the order a serial visit would give.
+        for (size_t i = 0; i < numChunks; i++) {
+            futures[i].get();
+
+            auto& result = results[i];
+            main.alloc.steal(std::move(result.alloc));
+            main.commits.merge(std::move(result.commits));
+            main.tempTrees.insert(main.tempTrees.end(),
+                                  std::make_move_iterator(result.tempTrees.begin()),
+                                  std::make_move_iterator(result.tempTrees.end()));
+        }
+
+        if constexpr (requires { mainRewriter.visitToken(unit.endOfFile); })
+            mainRewriter.visitToken(unit.endOfFile);
+
+        if (main.commits.empty())
+            return tree;
+
+        return transformTree(std::move(main.alloc), tree, main.commits, main.tempTrees, library);
+    }
+
 protected:
     using Token = parsing::Token;
 
@@ -39,6 +39,9 @@ public:
     /// additional writes are performed.
     std::string_view view() const;
 
+    /// Clears all emitted text so that the writer can be reused.
+    void clear();
+
     /// Begins a new JSON object. It's expected that you will write zero or
     /// more properties and then end the object.
     void startObject();
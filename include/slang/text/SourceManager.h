@@ -7,7 +7,9 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <bit>
 #include <expected.hpp>
 #include <filesystem>
 #include <memory>
@@ -15,6 +17,7 @@
 #include <set>
 #include <shared_mutex>
 #include <span>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -27,10 +30,6 @@ namespace slang {
 
 enum class DiagnosticSeverity;
 
-template<typename T>
-concept IsLock = std::is_same_v<T, std::shared_lock<std::shared_mutex>> ||
-                 std::is_same_v<T, std::unique_lock<std::shared_mutex>>;
-
 /// SourceManager - Handles loading and tracking source files.
 ///
 /// The source manager abstracts away the differences between
@@ -38,6 +37,9 @@ concept IsLock = std::is_same_v<T, std::shared_lock<std::shared_mutex>> ||
 /// See SourceLocation for more details.
 ///
 /// The methods in this class are thread safe unless otherwise noted.
+/// Queries about existing buffers and locations (line numbers, file names,
+/// macro expansion info, etc) don't take any locks, so they can be called
+/// freely from many threads at once, for example while parsing in parallel.
 class SLANG_EXPORT SourceManager {
 public:
     using BufferOrError = nonstd::expected<SourceBuffer, std::error_code>;
@@ -218,6 +220,77 @@ public:
     std::vector<BufferID> getAllBuffers() const;
 
 private:
+    // An append-only table whose entries are stored in chunks that double in size
+    // and are never moved or freed once allocated, so readers can look up an entry
+    // without a lock. Appending requires holding the write lock.
+    template<typename T, uint32_t FirstChunkBits>
+    class ChunkedTable {
+    public:
+        ChunkedTable() = default;
+        ChunkedTable(const ChunkedTable&) = delete;
+        ChunkedTable& operator=(const ChunkedTable&) = delete;
+
+        ~ChunkedTable() {
+            for (auto& chunk : chunks)
+                delete[] chunk.load(std::memory_order_relaxed);
+        }
+
+        // Gets the number of published entries.
+        uint32_t size() const { return count.load(std::memory_order_acquire); }
+
+        // Gets the entry at the given index, or nullptr if it hasn't been published.
+        const T* get(uint32_t index) const {
+            // The acquire load of the count synchronizes with the release in append(),
+            // which happens after the chunk pointer and the entry are written.
+            if (index >= size())
+                return nullptr;
+
+            auto [chunk, offset] = getPosition(index);
+            return chunks[chunk].load(std::memory_order_relaxed) + offset;
+        }
+
+        T* get(uint32_t index) { return const_cast<T*>(std::as_const(*this).get(index)); }
+
+        // Constructs a new entry and publishes it to readers. For tables of variants,
+        // @a U selects the alternative to construct in place.
+        template<typename U = T, typename... Args>
+        uint32_t append(Args&&... args) {
+            uint32_t index = count.load(std::memory_order_relaxed);
+            auto& entry = getOrAllocate(index);
+            if constexpr (std::is_same_v<U, T>)
+                entry = T(std::forward<Args>(args)...);
+            else
+                entry.template emplace<U>(std::forward<Args>(args)...);
+
+            count.store(index + 1, std::memory_order_release);
+            return index;
+        }
+
+    private:
+        static constexpr size_t NumChunks = 33 - FirstChunkBits;
+
+        // Chunk k holds 2^(FirstChunkBits + k) entries, so offsetting the index by the
+        // size of the first chunk makes its highest set bit select the chunk.
+        static std::pair<size_t, size_t> getPosition(uint32_t index) {
+            uint64_t biased = uint64_t(index) + (uint64_t(1) << FirstChunkBits);
+            size_t chunk = size_t(std::bit_width(biased)) - 1 - FirstChunkBits;
+            return {chunk, size_t(biased - (uint64_t(1) << (chunk + FirstChunkBits)))};
+        }
+
+        T& getOrAllocate(uint32_t index) {
+            auto [chunk, offset] = getPosition(index);
+            auto entries = chunks[chunk].load(std::memory_order_relaxed);
+            if (!entries) {
+                entries = new T[size_t(1) << (chunk + FirstChunkBits)];
+                chunks[chunk].store(entries, std::memory_order_relaxed);
+            }
+            return entries[offset];
+        }
+
+        std::array<std::atomic<T*>, NumChunks> chunks{};
+        std::atomic<uint32_t> count = 0;
+    };
+
     // Stores information specified in a `line directive, which alters the
     // line number and file name that we report in diagnostics.
     struct LineDirectiveInfo {
@@ -226,15 +299,20 @@ private:
         size_t lineOfDirective; // Line number set by directive
         uint8_t level;          // Level of directive. Either 0, 1, or 2.
 
+        LineDirectiveInfo() = default;
         LineDirectiveInfo(std::string&& fname, size_t lif, size_t lod, uint8_t level) noexcept :
             name(std::move(fname)), lineInFile(lif), lineOfDirective(lod), level(level) {}
     };
 
+    // Line directives are rare, so most files get by with a tiny first chunk.
+    using LineDirectiveTable = ChunkedTable<LineDirectiveInfo, 2>;
+
     // Stores actual file contents and metadata; only one per loaded file
     struct FileData {
         const std::string name;                       // name of the file
         const SmallVector<char> mem;                  // file contents
         std::vector<size_t> lineOffsets;              // cache of compute line offsets
+        std::atomic<bool> hasLineOffsets = false;     // set once lineOffsets is filled in
         const std::filesystem::path* const directory; // directory in which the file exists
         const std::filesystem::path fullPath;         // full path to the file
 
@@ -251,7 +329,10 @@ private:
         const SourceLibrary* library = nullptr;
         SourceLocation includedFrom;
         uint64_t sortKey;
-        std::vector<LineDirectiveInfo> lineDirectives;
+
+        // Allocated when the first line directive is added to the file;
+        // directives are appended in file order.
+        std::atomic<LineDirectiveTable*> lineDirectives = nullptr;
 
         FileInfo() {}
         FileInfo(FileData* data, const SourceLibrary* library, SourceLocation includedFrom,
@@ -261,6 +342,11 @@ private:
         // Returns a pointer to the LineDirectiveInfo for the nearest enclosing
         // line directive of the given raw line number, or nullptr if there is none
         const LineDirectiveInfo* getPreviousLineDirective(size_t rawLineNumber) const;
+
+        bool hasLineDirectives() const {
+            auto directives = lineDirectives.load(std::memory_order_acquire);
+            return directives && directives->size() > 0;
+        }
     };
 
     // Instead of a file, this lets a BufferID point to a macro expansion location.
@@ -286,7 +372,13 @@ private:
             originalLoc(originalLoc), expansionRange(expansionRange), macroName(macroName) {}
     };
 
-    // This mutex protects pretty much everything in this class.
+    using BufferEntry = std::variant<FileInfo, ExpansionInfo>;
+
+    using BufferTable = ChunkedTable<BufferEntry, 8>;
+
+    // This mutex protects everything in this class that gets modified,
+    // aside from the include directory lists. Readers of the buffer table
+    // and of existing file data don't need to take it.
     mutable std::shared_mutex mutex;
 
     // This mutex is specifically for protecting the system and user
@@ -294,7 +386,10 @@ private:
     mutable std::shared_mutex includeDirMutex;
 
     // index from BufferID to buffer metadata
-    std::vector<std::variant<FileInfo, ExpansionInfo>> bufferEntries;
+    BufferTable bufferEntries;
+
+    // backing memory for the line directive tables of every file that has any
+    std::vector<std::unique_ptr<LineDirectiveTable>> lineDirectiveStorage;
 
     // cache for file lookups; this holds on to the actual file data
     flat_hash_map<std::string, std::pair<std::unique_ptr<FileData>, std::error_code>> lookupCache;
@@ -312,11 +407,9 @@ private:
     std::atomic<uint32_t> unnamedBufferCount = 0;
     bool disableProximatePaths = false;
 
-    template<IsLock TLock>
-    FileInfo* getFileInfo(BufferID buffer, TLock& lock);
-
-    template<IsLock TLock>
-    const FileInfo* getFileInfo(BufferID buffer, TLock& lock) const;
+    FileInfo* getFileInfo(BufferID buffer);
+    const FileInfo* getFileInfo(BufferID buffer) const;
+    const ExpansionInfo* getExpansionInfo(BufferID buffer) const;
 
     SourceBuffer createBufferEntry(FileData* fd, SourceLocation includedFrom,
                                    const SourceLibrary* library, uint64_t sortKey,
@@ -328,23 +421,12 @@ private:
                              SourceLocation includedFrom, const SourceLibrary* library,
                              uint64_t sortKey, SmallVector<char>&& buffer);
 
-    template<IsLock TLock>
-    size_t getRawLineNumber(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    bool isMacroLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    bool isMacroArgLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    SourceLocation getFullyExpandedLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    SourceLocation getOriginalLocImpl(SourceLocation location, TLock& lock) const;
-
-    template<IsLock TLock>
-    SourceRange getExpansionRangeImpl(SourceLocation location, TLock& lock) const;
+    size_t getRawLineNumber(SourceLocation location) const;
+    bool isMacroLocImpl(SourceLocation location) const;
+    bool isMacroArgLocImpl(SourceLocation location) const;
+    SourceLocation getFullyExpandedLocImpl(SourceLocation location) const;
+    SourceLocation getOriginalLocImpl(SourceLocation location) const;
+    SourceRange getExpansionRangeImpl(SourceLocation location) const;
 
     static void computeLineOffsets(const SmallVector<char>& buffer,
                                    std::vector<size_t>& offsets) noexcept;
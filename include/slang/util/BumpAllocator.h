@@ -65,6 +65,10 @@ public:
         return std::span<T>(dest, len);
     }
 
+    /// Gets the total number of bytes handed out by the allocator so far,
+    /// including alignment padding but not unused space at the end of segments.
+    size_t getBytesUsed() const;
+
     /// Steals ownership of all of the memory contents of the given allocator.
     /// The other allocator will be in a moved-from state after the call.
     void steal(BumpAllocator&& other);
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------------
+//! @file CowPtr.h
+//! @brief Copy-on-write smart pointer
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <memory>
+
+namespace slang {
+
+/// A smart pointer that allocates its pointee on the heap and provides value
+/// semantics via copy-on-write. Copying the pointer is cheap and shares the
+/// pointee; the first mutable access through a pointer whose pointee is shared
+/// makes a private copy first, so no copy can ever observe another's changes.
+///
+/// Note that references or iterators obtained through mutable access are only
+/// valid until the pointer is next copied; after that a further mutable access
+/// may move the pointer to a new private copy.
+template<typename T>
+class CowPtr {
+public:
+    using pointer = T*;
+
+    CowPtr() {}
+    CowPtr(std::nullptr_t) {}
+
+    CowPtr(const CowPtr& other) = default;
+    CowPtr(CowPtr&& other) noexcept = default;
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    CowPtr(const U& other) : ptr(std::make_shared<T>(other)) {}
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    CowPtr(U&& other) : ptr(std::make_shared<T>(std::forward<U>(other))) {}
+
+    T* get() {
+        unshare();
+        return ptr.get();
+    }
+    const T* get() const { return ptr.get(); }
+
+    T* operator->() { return get(); }
+    const T* operator->() const { return get(); }
+    decltype(auto) operator*() { return *get(); }
+    decltype(auto) operator*() const { return *get(); }
+
+    explicit operator bool() const { return ptr != nullptr; }
+
+    /// Returns true if the pointee is currently shared with other pointers.
+    bool isShared() const { return ptr.use_count() > 1; }
+
+    CowPtr& operator=(std::nullptr_t) {
+        ptr.reset();
+        return *this;
+    }
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    CowPtr& operator=(const U& other) {
+        ptr = std::make_shared<T>(other);
+        return *this;
+    }
+
+    template<typename U>
+        requires std::is_convertible_v<U*, T*>
+    CowPtr& operator=(U&& other) {
+        ptr = std::make_shared<T>(std::forward<U>(other));
+        return *this;
+    }
+
+    CowPtr& operator=(const CowPtr& other) = default;
+    CowPtr& operator=(CowPtr&& other) noexcept = default;
+
+    template<typename U>
+    bool operator==(const CowPtr<U>& rhs) const {
+        return get() == rhs.get();
+    }
+
+    template<typename U>
+    auto operator<=>(const CowPtr<U>& rhs) const {
+        return get() <=> rhs.get();
+    }
+
+private:
+    void unshare() {
+        // If we're the only owner nobody else can start sharing
+        // the pointee out from under us, so this check is sufficient.
+        if (ptr.use_count() > 1)
+            ptr = std::make_shared<T>(*ptr);
+    }
+
+    std::shared_ptr<T> ptr;
+};
+
+} // namespace slang
@@ -16,12 +16,15 @@
 #include "slang/ast/SystemSubroutine.h"
 #include "slang/ast/types/TypePrinter.h"
 #include "slang/diagnostics/DiagnosticEngine.h"
+#include "slang/diagnostics/JsonDiagnosticClient.h"
 #include "slang/diagnostics/LookupDiags.h"
 #include "slang/diagnostics/StatementsDiags.h"
 #include "slang/diagnostics/TextDiagnosticClient.h"
 #include "slang/parsing/Parser.h"
+#include "slang/parsing/ParserMetadata.h"
 #include "slang/parsing/Preprocessor.h"
 #include "slang/syntax/SyntaxTree.h"
+#include "slang/syntax/SyntaxVisitor.h"
 #include "slang/text/CharInfo.h"
 #include "slang/text/SourceManager.h"
 #include "slang/util/TimeTrace.h"
@@ -163,11 +166,13 @@ Compilation::Compilation(const Bag& options, const SourceLibrary* defaultLib) :
     static std::once_flag onceFlag;
     std::call_once(onceFlag, [] {
         DiagnosticEngine::setDefaultFormatter<const Type*>(std::make_unique<TypeArgFormatter>());
-        TextDiagnosticClient::setDefaultSymbolPathCB([](const Symbol& sym) {
+        auto symbolPathCB = [](const Symbol& sym) {
             std::string str;
             sym.getHierarchicalPath(str);
             return str;
-        });
+        };
+        TextDiagnosticClient::setDefaultSymbolPathCB(symbolPathCB);
+        JsonDiagnosticClient::setDefaultSymbolPathCB(symbolPathCB);
     });
 
     // Reset systemId counters that may have been changed due to creation of types
@@ -177,7 +182,9 @@ Compilation::Compilation(const Bag& options, const SourceLibrary* defaultLib) :
     nextUnionSystemId = 1;
 }
 
-Compilation::~Compilation() = default;
+Compilation::~Compilation() {
+    delete[] typeRelationCache.load(std::memory_order_relaxed);
+}
 
 void Compilation::addSyntaxTree(std::shared_ptr<SyntaxTree> tree) {
     if (!tree)
@@ -375,7 +382,10 @@ const RootSymbol& Compilation::getRoot(bool skipDefParamsAndBinds) {
                 }
 
                 // Otherwise this definition is unreferenced and not automatically instantiated.
-                unreferencedDefs.push_back(&def);
+                // Definitions whose bodies were never parsed are skipped entirely; not having
+                // to look at them is the whole point of deferring them.
+                if (!def.hasDeferredBody())
+                    unreferencedDefs.push_back(&def);
             }
         }
     }
@@ -501,7 +511,8 @@ const RootSymbol& Compilation::getRoot(bool skipDefParamsAndBinds) {
 
                 auto& def = defSym->as<DefinitionSymbol>();
                 if (globalInstantiations.find(def.name) == globalInstantiations.end() &&
-                    def.sourceLibrary.isDefault && def.getInstanceCount() == 0) {
+                    def.sourceLibrary.isDefault && def.getInstanceCount() == 0 &&
+                    !def.hasDeferredBody()) {
                     unreferencedDefs.push_back(&def);
                 }
             }
@@ -515,6 +526,9 @@ const RootSymbol& Compilation::getRoot(bool skipDefParamsAndBinds) {
     });
     std::ranges::sort(unreferencedDefs, [](auto a, auto b) { return a->name < b->name; });
 
+    for (auto& [result, _] : topDefs)
+        parseDeferredBody(result.definition);
+
     // If we have any cli param overrides we should apply them to
     // each top-level instance.
     // TODO: generalize these to full hierarchical paths
@@ -576,6 +590,13 @@ const CompilationUnitSymbol* Compilation::getCompilationUnit(
 
 Compilation::DefinitionLookupResult Compilation::tryGetDefinition(std::string_view lookupName,
                                                                   const Scope& scope) const {
+    auto result = findDefinition(lookupName, scope);
+    parseDeferredBody(result.definition);
+    return result;
+}
+
+Compilation::DefinitionLookupResult Compilation::findDefinition(std::string_view lookupName,
+                                                                const Scope& scope) const {
     // Try to find a config block for this scope to help choose the right definition.
     const ResolvedConfig* resolvedConfig = nullptr;
     if (auto inst = scope.getContainingInstance(); inst && inst->parentInstance)
@@ -623,6 +644,33 @@ Compilation::DefinitionLookupResult Compilation::tryGetDefinition(std::string_vi
     return defList.empty() ? DefinitionLookupResult{} : DefinitionLookupResult{defList.front()};
 }
 
+void Compilation::parseDeferredBody(const Symbol* symbol) const {
+    if (!symbol || symbol->kind != SymbolKind::Definition)
+        return;
+
+    auto& def = const_cast<DefinitionSymbol&>(symbol->as<DefinitionSymbol>());
+    if (!def.hasDeferredBody())
+        return;
+
+    // The definition is being used for the first time, so its body
+    // needs to be parsed now. The new syntax lives in our own memory.
+    auto& comp = const_cast<Compilation&>(*this);
+    auto& oldSyntax = def.getSyntax()->as<ModuleDeclarationSyntax>();
+
+    Diagnostics diagnostics;
+    auto newSyntax = def.syntaxTree->parseDeferredBody(oldSyntax, comp, diagnostics);
+    def.getParentScope()->addDiags(diagnostics);
+    if (!newSyntax)
+        return;
+
+    auto metadata = syntaxMetadata.at(&oldSyntax);
+    auto defList = definitionFromSyntax.at(&oldSyntax);
+    comp.syntaxMetadata[newSyntax] = metadata;
+    comp.definitionFromSyntax[newSyntax] = std::move(defList);
+
+    def.setParsedBody(*newSyntax, metadata.timeScale);
+}
+
 static Token getExternNameToken(const SyntaxNode& sn) {
     return sn.kind == SyntaxKind::ExternModuleDecl ? sn.as<ExternModuleDeclSyntax>().header->name
                                                    : sn.as<ExternUdpDeclSyntax>().name;
@@ -650,6 +698,7 @@ Compilation::DefinitionLookupResult Compilation::getDefinition(std::string_view
     else
         result = resolveConfigRules(lookupName, scope, nullptr, &configRule, {});
 
+    parseDeferredBody(result.first.definition);
     if (!result.first.definition && !result.second) {
         // No definition found and no error issued, so issue one ourselves.
         auto diag = errorMissingDef(lookupName, scope, sourceRange, code);
@@ -712,8 +761,10 @@ const DefinitionSymbol* Compilation::getDefinition(const Scope& scope,
 
         auto lookupScope = &scope;
         do {
-            if (auto scopeIt = scopeMap.find(lookupScope); scopeIt != scopeMap.end())
+            if (auto scopeIt = scopeMap.find(lookupScope); scopeIt != scopeMap.end()) {
+                parseDeferredBody(scopeIt->second);
                 return scopeIt->second;
+            }
 
             lookupScope = lookupScope->asSymbol().getParentScope();
         } while (lookupScope);
@@ -743,6 +794,7 @@ const DefinitionSymbol* Compilation::getDefinition(const ConfigBlockSymbol& conf
 
         if (foundDef && (foundDef->definitionKind == DefinitionKind::Module ||
                          foundDef->definitionKind == DefinitionKind::Program)) {
+            parseDeferredBody(foundDef);
             return foundDef;
         }
     }
@@ -1316,6 +1368,12 @@ void Compilation::elaborate() {
     if (elabVisitor.finishedEarly())
         return;
 
+    const Symbol* root = &getRoot();
+    finishElaboration(elabVisitor, {&root, 1});
+}
+
+void Compilation::finishElaboration(DiagnosticVisitor& elabVisitor,
+                                    std::span<const Symbol* const> postElabRoots) {
     elabVisitor.finalize();
 
     // Note for the following checks here: anything that depends on a list
@@ -1450,7 +1508,8 @@ void Compilation::elaborate() {
         }
 
         PostElabVisitor postElabVisitor(*this);
-        getRoot().visit(postElabVisitor);
+        for (auto symbol : postElabRoots)
+            symbol->visit(postElabVisitor);
     }
 }
 
@@ -1463,7 +1522,7 @@ const Diagnostics& Compilation::getParseDiagnostics() {
         cachedParseDiagnostics->append_range(tree->diagnostics());
 
     if (sourceManager)
-        cachedParseDiagnostics->sort(*sourceManager);
+        cachedParseDiagnostics->sort(*sourceManager, options.numThreads);
     return *cachedParseDiagnostics;
 }
 
@@ -1474,8 +1533,17 @@ const Diagnostics& Compilation::getSemanticDiagnostics() {
     // Elaborate the design.
     elaborate();
 
+    cachedSemanticDiagnostics.emplace(collectSemanticDiags([](const Diagnostic&) { return true; }));
+    return *cachedSemanticDiagnostics;
+}
+
+Diagnostics Compilation::collectSemanticDiags(function_ref<bool(const Diagnostic&)> filter) {
     Diagnostics results;
     for (auto& [key, diagList] : diagMap) {
+        SLANG_ASSERT(!diagList.empty());
+        if (!filter(diagList.front()))
+            continue;
+
         // If the location is NoLocation, just issue each diagnostic.
         if (std::get<1>(key) == SourceLocation::NoLocation) {
             for (auto& diag : diagList)
@@ -1569,10 +1637,8 @@ const Diagnostics& Compilation::getSemanticDiagnostics() {
     }
 
     if (sourceManager)
-        results.sort(*sourceManager);
-
-    cachedSemanticDiagnostics.emplace(std::move(results));
-    return *cachedSemanticDiagnostics;
+        results.sort(*sourceManager, options.numThreads);
+    return results;
 }
 
 const Diagnostics& Compilation::getAllDiagnostics() {
@@ -1584,13 +1650,196 @@ const Diagnostics& Compilation::getAllDiagnostics() {
     cachedAllDiagnostics->append_range(getSemanticDiagnostics());
 
     if (sourceManager)
-        cachedAllDiagnostics->sort(*sourceManager);
+        cachedAllDiagnostics->sort(*sourceManager, options.numThreads);
     return *cachedAllDiagnostics;
 }
 
+Diagnostics Compilation::elaborateIncremental(
+    std::span<const std::shared_ptr<SyntaxTree>> changedTrees,
+    std::span<const std::shared_ptr<SyntaxTree>> previousTrees) {
+
+    // Find the set of affected trees: the changed ones plus anything that
+    // refers by name to a design element declared in an affected tree,
+    // iterated until we reach a fixed point.
+    flat_hash_set<const SyntaxTree*> affectedTrees;
+    flat_hash_set<std::string_view> affectedNames;
+    auto addDeclaredNames = [&](const SyntaxTree& tree) {
+        auto& meta = tree.getMetadata();
+        for (auto& [node, _] : meta.nodeMap) {
+            auto name = node->as<ModuleDeclarationSyntax>().header->name.valueText();
+            if (!name.empty())
+                affectedNames.emplace(name);
+        }
+
+        for (auto classDecl : meta.classDecls) {
+            auto name = classDecl->name.valueText();
+            if (!name.empty())
+                affectedNames.emplace(name);
+        }
+    };
+
+    auto markAffected = [&](const SyntaxTree& tree) {
+        if (!affectedTrees.emplace(&tree).second)
+            return false;
+
+        addDeclaredNames(tree);
+        return true;
+    };
+
+    auto refersToAffected = [&](const SyntaxTree& tree) {
+        auto& meta = tree.getMetadata();
+        for (auto name : meta.globalInstances) {
+            if (affectedNames.contains(name))
+                return true;
+        }
+
+        for (auto idName : meta.classPackageNames) {
+            if (affectedNames.contains(idName->identifier.valueText()))
+                return true;
+        }
+
+        for (auto importDecl : meta.packageImports) {
+            for (auto importItem : importDecl->items) {
+                if (affectedNames.contains(importItem->package.valueText()))
+                    return true;
+            }
+        }
+
+        for (auto intf : meta.interfacePorts) {
+            if (affectedNames.contains(intf->nameOrKeyword.valueText()))
+                return true;
+        }
+        return false;
+    };
+
+    // Names declared by the previous versions of the changed trees are affected
+    // too, so that anything referring to a removed or renamed design element
+    // gets re-elaborated.
+    for (auto& tree : changedTrees)
+        markAffected(*tree);
+    for (auto& tree : previousTrees)
+        addDeclaredNames(*tree);
+
+    bool anyAdded = true;
+    while (anyAdded) {
+        anyAdded = false;
+        for (auto& tree : syntaxTrees) {
+            if (!affectedTrees.contains(tree.get()) && refersToAffected(*tree))
+                anyAdded |= markAffected(*tree);
+        }
+    }
+
+    flat_hash_set<const SyntaxNode*> affectedSyntax;
+    for (auto tree : affectedTrees) {
+        affectedSyntax.emplace(&tree->root());
+        for (auto& [node, _] : tree->getMetadata().nodeMap)
+            affectedSyntax.emplace(node);
+    }
+
+    // Find the definitions whose bodies might (transitively) instantiate an affected
+    // definition, going only by the names instantiated in their syntax, so that the
+    // walk below can skip the rest of the hierarchy without elaborating any of it.
+    // Bind directives can add instances anywhere, so they disable this pruning.
+    auto& root = getRoot();
+    std::optional<flat_hash_set<const SyntaxNode*>> containingDefs;
+    if (bindDirectives.empty()) {
+        struct InstantiationVisitor : public SyntaxVisitor<InstantiationVisitor> {
+            void handle(const HierarchyInstantiationSyntax& syntax) {
+                names.push_back(syntax.type.valueText());
+            }
+
+            SmallVector<std::string_view> names;
+        };
+
+        SmallVector<std::pair<const ModuleDeclarationSyntax*, InstantiationVisitor>> defs;
+        flat_hash_set<std::string_view> containingNames;
+        for (auto& tree : syntaxTrees) {
+            for (auto& [node, _] : tree->getMetadata().nodeMap) {
+                auto& decl = node->as<ModuleDeclarationSyntax>();
+                if (affectedSyntax.contains(&decl)) {
+                    containingNames.emplace(decl.header->name.valueText());
+                    continue;
+                }
+
+                defs.emplace_back(&decl, InstantiationVisitor{});
+                decl.visit(defs.back().second);
+            }
+        }
+
+        containingDefs.emplace();
+        bool anyNew = true;
+        while (anyNew) {
+            anyNew = false;
+            for (auto& [decl, visitor] : defs) {
+                if (containingDefs->contains(decl))
+                    continue;
+
+                if (std::ranges::any_of(visitor.names,
+                                        [&](auto name) { return containingNames.contains(name); })) {
+                    containingDefs->emplace(decl);
+                    containingNames.emplace(decl->header->name.valueText());
+                    anyNew = true;
+                }
+            }
+        }
+    }
+
+    // Elaborate the compilation units of affected trees (which includes any
+    // packages they declare) along with every instance body in the hierarchy
+    // whose definition is affected and everything instantiated beneath those.
+    // Everything else is only created as needed. The same post-elaboration
+    // checks that a full elaboration does are then run over those symbols.
+    DiagnosticVisitor elabVisitor(*this, numErrors,
+                                  options.errorLimit == 0 ? UINT32_MAX : options.errorLimit);
+    elabVisitor.visitInstances = false;
+
+    SmallVector<const Symbol*> postElabRoots;
+    for (auto unit : root.compilationUnits) {
+        if (affectedSyntax.contains(unit->getSyntax())) {
+            unit->visit(elabVisitor);
+            postElabRoots.push_back(unit);
+        }
+    }
+
+    IncrementalElabVisitor visitor(*this, elabVisitor, affectedSyntax,
+                                   containingDefs ? &*containingDefs : nullptr);
+    for (auto inst : root.topInstances)
+        inst->visit(visitor);
+
+    if (!elabVisitor.finishedEarly()) {
+        postElabRoots.append_range(visitor.outermostBodies);
+        finishElaboration(elabVisitor, postElabRoots);
+    }
+
+    // Only return diagnostics that belong to affected design elements;
+    // anything else was elaborated incidentally and its diagnostics are
+    // the same as they were in the previous compilation.
+    return collectSemanticDiags([&](const Diagnostic& diag) {
+        auto symbol = diag.symbol;
+        while (symbol) {
+            if (symbol->kind == SymbolKind::InstanceBody) {
+                auto& body = symbol->as<InstanceBodySymbol>();
+                return visitor.affectedBodies.contains(&body) ||
+                       affectedSyntax.contains(body.getDefinition().getSyntax());
+            }
+
+            if (symbol->kind == SymbolKind::Package ||
+                symbol->kind == SymbolKind::CompilationUnit) {
+                return affectedSyntax.contains(symbol->getSyntax());
+            }
+
+            auto scope = symbol->getParentScope();
+            symbol = scope ? &scope->asSymbol() : nullptr;
+        }
+        return true;
+    });
+}
+
 void Compilation::addDiagnostics(const Diagnostics& diagnostics) {
-    for (auto& diag : diagnostics)
-        addDiag(diag);
+    for (auto& diag : diagnostics) {
+        if (!filterDiag(diag.code, diag.location))
+            addDiag(diag);
+    }
 }
 
 Diagnostic& Compilation::addDiag(Diagnostic diag) {
@@ -1631,6 +1880,116 @@ Diagnostic& Compilation::addDiag(Diagnostic diag) {
     return it->second.back();
 }
 
+Diagnostic* Compilation::filterDiag(DiagCode code, SourceLocation location) {
+    if (!diagFilter || getDefaultSeverity(code) >= DiagnosticSeverity::Error ||
+        !diagFilter(code, location)) {
+        return nullptr;
+    }
+
+    // Reset the scratch diagnostic in place so that its storage gets
+    // reused by whatever the caller writes into it.
+    numFilteredDiags++;
+    tempDiag.args.clear();
+    tempDiag.ranges.clear();
+    tempDiag.notes.clear();
+    tempDiag.coalesceCount.reset();
+    tempDiag.code = code;
+    tempDiag.location = location;
+    tempDiag.symbol = nullptr;
+    return &tempDiag;
+}
+
+// Strings longer than this aren't worth interning; they're rarely repeated
+// and hashing them costs more than the storage they might save.
+static constexpr size_t MaxInternedStringLength = 64;
+
+static bool isInternable(const ConstantValue& cv) {
+    if (cv.isInteger() || cv.isReal() || cv.isShortReal())
+        return true;
+    if (cv.isString())
+        return cv.str().size() <= MaxInternedStringLength;
+    return false;
+}
+
+// Returns the number of bytes used to store the given (internable) value,
+// including any heap storage it owns.
+static size_t constantStorageSize(const ConstantValue& cv) {
+    size_t size = sizeof(ConstantValue);
+    if (cv.isInteger()) {
+        auto& sv = cv.integer();
+        if (!sv.isSingleWord())
+            size += sv.getNumWords() * sizeof(uint64_t);
+    }
+    else if (cv.isString()) {
+        // Only count the characters if they don't fit in the small string buffer.
+        auto& str = cv.str();
+        auto data = reinterpret_cast<const std::byte*>(str.data());
+        auto self = reinterpret_cast<const std::byte*>(&str);
+        if (data < self || data >= self + sizeof(str))
+            size += str.capacity() + 1;
+    }
+    return size;
+}
+
+size_t Compilation::ConstantInternHash::operator()(const ConstantValue* cv) const {
+    // ConstantValue::hash doesn't distinguish between integers of different
+    // widths and signedness, or between positive and negative real zero,
+    // so mix in those details here.
+    size_t h = cv->hash();
+    if (cv->isInteger()) {
+        auto& sv = cv->integer();
+        hash_combine(h, sv.getBitWidth(), sv.isSigned());
+    }
+    else if (cv->isReal()) {
+        hash_combine(h, std::bit_cast<uint64_t>(double(cv->real())));
+    }
+    else if (cv->isShortReal()) {
+        hash_combine(h, std::bit_cast<uint32_t>(float(cv->shortReal())));
+    }
+    return h;
+}
+
+bool Compilation::ConstantInternEqual::operator()(const ConstantValue* lhs,
+                                                  const ConstantValue* rhs) const {
+    if (lhs->getVariant().index() != rhs->getVariant().index())
+        return false;
+
+    if (lhs->isInteger()) {
+        auto& l = lhs->integer();
+        auto& r = rhs->integer();
+        return l.getBitWidth() == r.getBitWidth() && l.isSigned() == r.isSigned() &&
+               exactlyEqual(l, r);
+    }
+
+    // Compare reals by their bit patterns so that -0.0 and 0.0 stay distinct
+    // and NaNs can still be shared.
+    if (lhs->isReal()) {
+        return std::bit_cast<uint64_t>(double(lhs->real())) ==
+               std::bit_cast<uint64_t>(double(rhs->real()));
+    }
+
+    if (lhs->isShortReal()) {
+        return std::bit_cast<uint32_t>(float(lhs->shortReal())) ==
+               std::bit_cast<uint32_t>(float(rhs->shortReal()));
+    }
+
+    return lhs->str() == rhs->str();
+}
+
+const ConstantValue* Compilation::allocConstant(ConstantValue&& value) {
+    if (!isInternable(value))
+        return constantAllocator.emplace(std::move(value));
+
+    if (auto it = internedConstants.find(&value); it != internedConstants.end()) {
+        internedConstantBytesSaved += constantStorageSize(value);
+        return *it;
+    }
+
+    auto result = constantAllocator.emplace(std::move(value));
+    internedConstants.emplace(result);
+    return result;
+}
+
 AssertionInstanceDetails* Compilation::allocAssertionDetails() {
     return assertionDetailsAllocator.emplace();
 }
@@ -1679,8 +2038,7 @@ const Type& Compilation::getType(bitwidth_t width, bitmask<IntegralFlags> flags)
     if (it != vectorTypeCache.end())
         return *it->second;
 
-    auto type = emplace<PackedArrayType>(getScalarType(flags), ConstantRange{int32_t(width - 1), 0},
-                                         width);
+    auto type = &getPackedArrayType(getScalarType(flags), ConstantRange{int32_t(width - 1), 0});
     vectorTypeCache.emplace_hint(it, key, type);
     return *type;
 }
@@ -1691,6 +2049,100 @@ const Type& Compilation::getScalarType(bitmask<IntegralFlags> flags) {
     return *ptr;
 }
 
+bool Compilation::checkTypeRelation(const Type& lhs, const Type& rhs, TypeRelation relation) {
+    auto compute = [relation](const Type& l, const Type& r) {
+        switch (relation) {
+            case TypeRelation::Matching:
+                return l.isMatching(r);
+            case TypeRelation::Equivalent:
+                return l.isEquivalent(r);
+            case TypeRelation::AssignmentCompatible:
+                return l.isAssignmentCompatible(r);
+            case TypeRelation::CastCompatible:
+                return l.isCastCompatible(r);
+        }
+        SLANG_UNREACHABLE;
+    };
+
+    // Identical types satisfy every relation, so there's no need to cache them.
+    auto l = &lhs.getCanonicalType();
+    auto r = &rhs.getCanonicalType();
+    if (l == r)
+        return true;
+
+    auto cache = typeRelationCache.load(std::memory_order_acquire);
+    if (!cache) {
+        auto fresh = new TypeRelationEntry[TypeRelationCacheSize];
+        if (typeRelationCache.compare_exchange_strong(cache, fresh, std::memory_order_acq_rel))
+            cache = fresh;
+        else
+            delete[] fresh;
+    }
+
+    size_t h = 0;
+    hash_combine(h, l, r, uint8_t(relation));
+
+    // Entries are published seqlock style: a reader only trusts the fields it
+    // read if the sequence number was even and unchanged around the reads.
+    auto& entry = cache[h % TypeRelationCacheSize];
+    auto seq = entry.seq.load(std::memory_order_acquire);
+    if ((seq & 1) == 0) {
+        auto el = entry.lhs.load(std::memory_order_relaxed);
+        auto er = entry.rhs.load(std::memory_order_relaxed);
+        auto packed = entry.relationAndResult.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.seq.load(std::memory_order_relaxed) == seq && el == l && er == r &&
+            (packed >> 1) == uint8_t(relation)) {
+            std::atomic_ref(typeRelationCacheStats.hits).fetch_add(1, std::memory_order_relaxed);
+            return (packed & 1) != 0;
+        }
+    }
+
+    std::atomic_ref(typeRelationCacheStats.misses).fetch_add(1, std::memory_order_relaxed);
+    bool result = compute(*l, *r);
+
+    // If another thread is writing this entry just skip caching the result.
+    if ((seq & 1) == 0 &&
+        entry.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed)) {
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.lhs.store(l, std::memory_order_relaxed);
+        entry.rhs.store(r, std::memory_order_relaxed);
+        entry.relationAndResult.store(uint8_t((uint8_t(relation) << 1) | uint8_t(result)),
+                                      std::memory_order_relaxed);
+        entry.seq.store(seq + 2, std::memory_order_release);
+    }
+    return result;
+}
+
+const Type& Compilation::getPackedArrayType(const Type& elementType, ConstantRange range,
+                                            const SyntaxNode* syntax) {
+    auto [it, inserted] = packedArrayCache.try_emplace(
+        {&elementType, range.left, range.right, syntax});
+    if (inserted) {
+        auto result = emplace<PackedArrayType>(elementType, range,
+                                               elementType.getBitWidth() * range.width());
+        if (syntax)
+            result->setSyntax(*syntax);
+        it->second = result;
+    }
+    return *it->second;
+}
+
+const Type& Compilation::getUnpackedArrayType(const Type& elementType, ConstantRange range,
+                                              const SyntaxNode* syntax) {
+    auto [it, inserted] = unpackedArrayCache.try_emplace(
+        {&elementType, range.left, range.right, syntax});
+    if (inserted) {
+        auto result = emplace<FixedSizeUnpackedArrayType>(
+            elementType, range, elementType.getSelectableWidth() * range.width(),
+            elementType.getBitstreamWidth() * range.width());
+        if (syntax)
+            result->setSyntax(*syntax);
+        it->second = result;
+    }
+    return *it->second;
+}
+
 const NetType& Compilation::getNetType(TokenKind kind) const {
     auto it = knownNetTypes.find(kind);
     return it == knownNetTypes.end() ? *knownNetTypes.find(TokenKind::Unknown)->second
@@ -7,9 +7,13 @@
 //------------------------------------------------------------------------------
 #pragma once
 
+#include <deque>
+
 #include "slang/ast/ASTVisitor.h"
+#include "slang/ast/EvalContext.h"
 #include "slang/diagnostics/CompilationDiags.h"
 #include "slang/diagnostics/DeclarationsDiags.h"
+#include "slang/util/ThreadPool.h"
 #include "slang/util/TimeTrace.h"
 
 namespace slang::ast {
@@ -336,8 +340,84 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
             return;
         }
 
-        if (visitInstances)
+        if (visitInstances) {
+            evalSelfContainedParams(symbol.body);
             visit(symbol.body);
+        }
+    }
+
+    // Cell libraries can have many thousands of parameters and specparams whose
+    // initializers are simple constant expressions that don't depend on anything else.
+    // Evaluate all such initializers in the given body concurrently ahead of visiting it;
+    // the visit will then find their values already computed.
+    void evalSelfContainedParams(const InstanceBodySymbol& body) {
+        const uint32_t numThreads = compilation.getOptions().numThreads;
+        if (numThreads == 1 || finishedEarly())
+            return;
+
+        SmallVector<std::pair<const Symbol*, const Expression*>> toEval;
+        auto addParams = [&](const Scope& scope) {
+            for (auto& member : scope.members()) {
+                const Expression* init = nullptr;
+                if (member.kind == SymbolKind::Parameter)
+                    init = member.as<ParameterSymbol>().getSelfContainedInitializer();
+                else if (member.kind == SymbolKind::Specparam)
+                    init = member.as<SpecparamSymbol>().getSelfContainedInitializer();
+
+                if (init)
+                    toEval.emplace_back(&member, init);
+            }
+        };
+
+        addParams(body);
+        for (auto& block : body.membersOfType<SpecifyBlockSymbol>())
+            addParams(block);
+
+        if (toEval.size() < MinParamsForThreading)
+            return;
+
+        // Each evaluation gets its own context that defers caching results in the AST,
+        // so the evaluations don't touch any shared state and can run concurrently.
+        std::deque<EvalContext> contexts;
+        for (auto [symbol, _] : toEval) {
+            // Set up the contexts the same way the serial getValue() calls do.
+            auto& scope = *symbol->getParentScope();
+            bitmask<EvalFlags> flags = EvalFlags::CacheResults | EvalFlags::DeferCaching;
+            if (symbol->kind == SymbolKind::Parameter) {
+                ASTContext astCtx(scope, LookupLocation::max);
+                if (symbol->as<ParameterSymbol>().isFromConfig())
+                    astCtx.flags |= ASTFlags::ConfigParam;
+
+                contexts.emplace_back(astCtx, flags | EvalFlags::AllowUnboundedPlaceholder);
+            }
+            else {
+                ASTContext astCtx(scope, LookupLocation::before(*symbol),
+                                  ASTFlags::SpecparamInitializer);
+                contexts.emplace_back(astCtx, flags | EvalFlags::SpecparamsAllowed);
+            }
+        }
+
+        if (!threadPool)
+            threadPool = std::make_unique<ThreadPool>(numThreads);
+
+        std::vector<ConstantValue> results(toEval.size());
+        threadPool->pushLoop(size_t(0), toEval.size(), [&](size_t start, size_t end) {
+            for (size_t i = start; i < end; i++)
+                results[i] = toEval[i].second->eval(contexts[i]);
+        });
+        threadPool->waitForAll();
+
+        for (size_t i = 0; i < toEval.size(); i++) {
+            auto& context = contexts[i];
+            context.applyDeferredCaching();
+            context.reportAllDiags();
+
+            auto symbol = toEval[i].first;
+            if (symbol->kind == SymbolKind::Parameter)
+                symbol->as<ParameterSymbol>().setInitializerValue(std::move(results[i]));
+            else
+                symbol->as<SpecparamSymbol>().setInitializerValue(std::move(results[i]));
+        }
     }
 
     void handle(const SubroutineSymbol& symbol) {
@@ -454,9 +534,12 @@ struct DiagnosticVisitor : public ASTVisitor<DiagnosticVisitor, false, false> {
         }
     }
 
+    static constexpr size_t MinParamsForThreading = 64;
+
     Compilation& compilation;
     const size_t& numErrors;
     uint32_t errorLimit;
+    std::unique_ptr<ThreadPool> threadPool;
     bool visitInstances = true;
     bool hierarchyProblem = false;
     flat_hash_set<const InstanceBodySymbol*> activeInstanceBodies;
@@ -784,4 +867,64 @@ private:
     Compilation& compilation;
 };
 
+// This visitor is used for incremental elaboration. It walks the instance hierarchy
+// without binding any statements or expressions, and runs the given diagnostic visitor
+// only over those instance bodies whose definitions are in the given set of affected
+// syntax, along with everything instantiated beneath them. If a set of containing
+// definitions is provided, bodies whose definitions aren't in it can't contain an
+// affected instance and so are skipped without elaborating their members at all.
+struct IncrementalElabVisitor : public ASTVisitor<IncrementalElabVisitor, false, false> {
+    IncrementalElabVisitor(Compilation& compilation, DiagnosticVisitor& elabVisitor,
+                           const flat_hash_set<const syntax::SyntaxNode*>& affectedSyntax,
+                           const flat_hash_set<const syntax::SyntaxNode*>* containingDefs) :
+        compilation(compilation), elabVisitor(elabVisitor), affectedSyntax(affectedSyntax),
+        containingDefs(containingDefs) {}
+
+    void handle(const InstanceSymbol& symbol) {
+        if (elabVisitor.finishedEarly())
+            return;
+
+        // Everything underneath an affected instance is affected as well, since
+        // parameter values and port connections flow down into child instances.
+        auto defSyntax = symbol.getDefinition().getSyntax();
+        const bool affected = affectedDepth > 0 || affectedSyntax.contains(defSyntax);
+        if (!affected && containingDefs && !containingDefs->contains(defSyntax))
+            return;
+
+        // Guard against infinitely recursive hierarchies; the full elaboration
+        // pass is responsible for reporting those.
+        if (activeInstanceBodies.size() > compilation.getOptions().maxInstanceDepth ||
+            !activeInstanceBodies.emplace(&symbol.body).second) {
+            return;
+        }
+
+        if (affected) {
+            elabVisitor.evalSelfContainedParams(symbol.body);
+            symbol.body.visit(elabVisitor);
+            affectedBodies.emplace(&symbol.body);
+            if (affectedDepth == 0)
+                outermostBodies.push_back(&symbol.body);
+            affectedDepth++;
+        }
+
+        visitDefault(symbol);
+
+        if (affected)
+            affectedDepth--;
+        activeInstanceBodies.erase(&symbol.body);
+    }
+
+    // Instances can't appear inside subroutines, so don't bother walking them.
+    void handle(const SubroutineSymbol&) {}
+
+    Compilation& compilation;
+    DiagnosticVisitor& elabVisitor;
+    const flat_hash_set<const syntax::SyntaxNode*>& affectedSyntax;
+    const flat_hash_set<const syntax::SyntaxNode*>* containingDefs;
+    flat_hash_set<const InstanceBodySymbol*> activeInstanceBodies;
+    flat_hash_set<const InstanceBodySymbol*> affectedBodies;
+    SmallVector<const Symbol*> outermostBodies;
+    uint32_t affectedDepth = 0;
+};
+
 } // namespace slang::ast
@@ -9,6 +9,7 @@
 
 #include "slang/ast/ASTContext.h"
 #include "slang/ast/Compilation.h"
+#include "slang/ast/Expression.h"
 #include "slang/ast/symbols/SubroutineSymbols.h"
 #include "slang/ast/symbols/VariableSymbols.h"
 #include "slang/ast/types/Type.h"
@@ -23,15 +24,32 @@ void EvalContext::reset() {
     queueTarget = nullptr;
     stack.clear();
     lvalStack.clear();
+    deferredCache.clear();
     diags.clear();
     warnings.clear();
     disableRange = {};
     backtraceReported = false;
 }
 
+// Gets the index of the given symbol's storage within the frame's dense
+// list of locals, or nullopt if it needs to be stored as a temporary instead.
+static std::optional<size_t> findSlot(const EvalContext::Frame& frame,
+                                      const ValueSymbol* symbol) {
+    if (frame.locals.empty() || !VariableSymbol::isKind(symbol->kind))
+        return std::nullopt;
+
+    auto slot = symbol->as<VariableSymbol>().getFrameSlot();
+    if (slot >= frame.locals.size() || frame.subroutine->getLocalSlots()[slot] != symbol)
+        return std::nullopt;
+
+    return slot;
+}
+
 ConstantValue* EvalContext::createLocal(const ValueSymbol* symbol, ConstantValue value) {
     SLANG_ASSERT(!stack.empty());
-    ConstantValue& result = stack.back().temporaries[symbol];
+    auto& frame = stack.back();
+    auto slot = findSlot(frame, symbol);
+    ConstantValue& result = slot ? frame.locals[*slot].emplace() : frame.temporaries[symbol];
     if (!value) {
         result = symbol->getType().getDefaultValue();
     }
@@ -50,6 +68,11 @@ ConstantValue* EvalContext::findLocal(const ValueSymbol* symbol) {
         return nullptr;
 
     auto& frame = stack.back();
+    if (auto slot = findSlot(frame, symbol)) {
+        auto& local = frame.locals[*slot];
+        return local ? &*local : nullptr;
+    }
+
     auto it = frame.temporaries.find(symbol);
     if (it == frame.temporaries.end())
         return nullptr;
@@ -59,7 +82,10 @@ ConstantValue* EvalContext::findLocal(const ValueSymbol* symbol) {
 void EvalContext::deleteLocal(const ValueSymbol* symbol) {
     if (!stack.empty()) {
         auto& frame = stack.back();
-        frame.temporaries.erase(symbol);
+        if (auto slot = findSlot(frame, symbol))
+            frame.locals[*slot].reset();
+        else
+            frame.temporaries.erase(symbol);
     }
 }
 
@@ -75,6 +101,7 @@ bool EvalContext::pushFrame(const SubroutineSymbol& subroutine, SourceLocation c
     frame.subroutine = &subroutine;
     frame.callLocation = callLocation;
     frame.lookupLocation = lookupLocation;
+    frame.locals.resize(subroutine.getLocalSlots().size());
     stack.emplace_back(std::move(frame));
     return true;
 }
@@ -110,11 +137,32 @@ bool EvalContext::step(SourceLocation loc) {
     return false;
 }
 
+void EvalContext::deferCaching(const Expression& expr, ConstantValue value) {
+    deferredCache.emplace_back(&expr, std::move(value));
+}
+
+void EvalContext::applyDeferredCaching() {
+    auto& comp = getCompilation();
+    for (auto& [expr, value] : deferredCache) {
+        if (!expr->constant) {
+            expr->constant = value ? comp.allocConstant(std::move(value))
+                                   : &ConstantValue::Invalid;
+        }
+    }
+    deferredCache.clear();
+}
+
 std::string EvalContext::dumpStack() const {
     FormatBuffer buffer;
     int index = 0;
     for (const Frame& frame : stack) {
         buffer.format("{}: {}\n", index++, frame.subroutine ? frame.subroutine->name : "<global>");
+        for (size_t i = 0; i < frame.locals.size(); i++) {
+            if (auto& value = frame.locals[i]) {
+                buffer.format("    {} = {}\n", frame.subroutine->getLocalSlots()[i]->name,
+                              value->toString());
+            }
+        }
         for (auto& [symbol, value] : frame.temporaries)
             buffer.format("    {} = {}\n", symbol->name, value.toString());
     }
@@ -171,10 +219,18 @@ static void reportFrame(Diagnostic& diag, const EvalContext::Frame& frame) {
     buffer.format("{}(", frame.subroutine->name);
 
     for (auto arg : frame.subroutine->getArguments()) {
-        auto it = frame.temporaries.find(arg);
-        SLANG_ASSERT(it != frame.temporaries.end());
+        const ConstantValue* value;
+        if (auto slot = findSlot(frame, arg)) {
+            SLANG_ASSERT(frame.locals[*slot]);
+            value = &*frame.locals[*slot];
+        }
+        else {
+            auto it = frame.temporaries.find(arg);
+            SLANG_ASSERT(it != frame.temporaries.end());
+            value = &it->second;
+        }
 
-        buffer.append(it->second.toString());
+        buffer.append(value->toString());
         if (arg != frame.subroutine->getArguments().last(1)[0])
             buffer.append(", ");
     }
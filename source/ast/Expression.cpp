@@ -29,13 +29,22 @@ struct EvalVisitor {
             return *expr.constant;
 
         if (expr.bad()) {
-            if (context.cacheResults())
-                expr.constant = &ConstantValue::Invalid;
+            if (context.cacheResults()) {
+                if (context.flags.has(EvalFlags::DeferCaching))
+                    context.deferCaching(expr, nullptr);
+                else
+                    expr.constant = &ConstantValue::Invalid;
+            }
             return nullptr;
         }
 
         ConstantValue cv = expr.evalImpl(context);
         if (cv && context.cacheResults()) {
+            if (context.flags.has(EvalFlags::DeferCaching)) {
+                context.deferCaching(expr, cv);
+                return cv;
+            }
+
             // If we're caching results we can't let any reported
             // diagnostics get lost because there won't be another
             // opportunity to see them, so make sure they get logged
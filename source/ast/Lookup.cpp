@@ -526,6 +526,40 @@ bool lookupDownward(std::span<const NamePlusLoc> nameParts, NameComponents name,
     return true;
 }
 
+// Walks the symbols that can match the first component of an upward name
+// lookup (see Lookup::getUpwardCandidates), calling @a func for each one in
+// order. The walk stops early as soon as @a func returns false.
+template<typename TFunc>
+void forEachUpwardCandidate(const Scope& initialScope, std::string_view name, TFunc&& func) {
+    const Scope* scope = &initialScope;
+    while (scope) {
+        // Search for a scope or instance target within our current scope.
+        auto symbol = scope->find(name);
+        if (symbol && !symbol->isValue() && !symbol->isType() &&
+            (symbol->isScope() || symbol->kind == SymbolKind::Instance)) {
+            if (!func(*symbol))
+                return;
+        }
+
+        // Advance to the next scope, skipping to the parent instance when
+        // we hit an instance body instead of going on to the compilation unit.
+        symbol = &scope->asSymbol();
+        if (symbol->kind != SymbolKind::InstanceBody) {
+            scope = symbol->getHierarchicalParent();
+        }
+        else {
+            auto inst = symbol->as<InstanceBodySymbol>().parentInstance;
+            SLANG_ASSERT(inst);
+
+            // If the instance's definition name matches our target name,
+            // try to match from the current instance.
+            scope = inst->getParentScope();
+            if (inst->getDefinition().name == name && !func(*inst))
+                return;
+        }
+    }
+}
+
 // Returns true if the lookup was ok, or if it failed in a way that allows us to continue
 // looking up in other ways. Returns false if the entire lookup has failed and should be
 // aborted.
@@ -547,41 +581,30 @@ bool lookupUpward(std::span<const NamePlusLoc> nameParts, const NameComponents&
         return lookupDownward(nameParts, name, context, flags, result);
     };
 
-    const Scope* scope = context.scope;
-    while (scope) {
-        // Search for a scope or instance target within our current scope.
-        auto symbol = scope->find(name.text);
-        if (symbol && !symbol->isValue() && !symbol->isType() &&
-            (symbol->isScope() || symbol->kind == SymbolKind::Instance)) {
-            if (!tryMatch(*symbol))
-                return false;
-
-            if (result.found)
-                return true;
-        }
-
-        // Advance to the next scope, skipping to the parent instance when
-        // we hit an instance body instead of going on to the compilation unit.
-        symbol = &scope->asSymbol();
-        if (symbol->kind != SymbolKind::InstanceBody) {
-            scope = symbol->getHierarchicalParent();
-        }
-        else {
-            auto inst = symbol->as<InstanceBodySymbol>().parentInstance;
-            SLANG_ASSERT(inst);
-
-            // If the instance's definition name matches our target name,
-            // try to match from the current instance.
-            scope = inst->getParentScope();
-            if (inst->getDefinition().name == name.text) {
-                if (!tryMatch(*inst))
-                    return false;
+    // Once the compilation is finalized the candidate list is cached and can be
+    // reused across lookups; before that, walk the scopes lazily so that we can
+    // stop as soon as the first candidate matches.
+    std::optional<bool> status;
+    auto visit = [&](const Symbol& symbol) {
+        if (!tryMatch(symbol))
+            status = false;
+        else if (result.found)
+            status = true;
+        return !status.has_value();
+    };
 
-                if (result.found)
-                    return true;
-            }
+    if (context.getCompilation().isFinalized()) {
+        for (auto symbol : Lookup::getUpwardCandidates(*context.scope, name.text)) {
+            if (!visit(*symbol))
+                break;
         }
     }
+    else {
+        forEachUpwardCandidate(*context.scope, name.text, visit);
+    }
+
+    if (status)
+        return *status;
 
     result.clear();
     if (firstMatch) {
@@ -1162,6 +1185,36 @@ const Symbol* Lookup::unqualifiedAt(const Scope& scope, std::string_view name,
     return result.found;
 }
 
+std::span<const Symbol* const> Lookup::getUpwardCandidates(const Scope& initialScope,
+                                                            std::string_view name) {
+    // Once the compilation is finalized the set of candidates for a given
+    // name and starting scope can't change, so it gets cached for future lookups.
+    auto& comp = initialScope.getCompilation();
+    const bool useCache = comp.isFinalized();
+    if (useCache) {
+        if (auto it = comp.upwardLookupCache.find({&initialScope, name});
+            it != comp.upwardLookupCache.end()) {
+            return it->second;
+        }
+    }
+
+    SmallVector<const Symbol*> candidates;
+    forEachUpwardCandidate(initialScope, name, [&](const Symbol& symbol) {
+        candidates.push_back(&symbol);
+        return true;
+    });
+
+    auto result = candidates.copy(comp);
+    if (useCache) {
+        // The name may not outlive this call so make a copy for the key.
+        auto nameCopy = comp.copyFrom(std::span(name));
+        comp.upwardLookupCache.emplace(
+            std::tuple(&initialScope, std::string_view(nameCopy.data(), nameCopy.size())),
+            result);
+    }
+    return result;
+}
+
 static const Symbol* selectSingleChild(const Symbol& symbol, const BitSelectSyntax& syntax,
                                        const ASTContext& context, LookupResult& result) {
     auto index = context.evalInteger(*syntax.expr);
@@ -1847,30 +1900,51 @@ void Lookup::unqualifiedImpl(const Scope& scope, std::string_view name, LookupLo
             }
         }
         else {
-            struct Import {
-                const Symbol* imported;
-                const WildcardImportSymbol* import;
-            };
-            SmallVector<Import, 4> imports;
-            SmallSet<const Symbol*, 2> importDedup;
+            auto& wildcardImports = wildcardImportData->wildcardImports;
+            auto visibleEnd = std::ranges::partition_point(wildcardImports, [&](auto import) {
+                return !(location < LookupLocation::after(*import));
+            });
+            auto numVisible = size_t(visibleEnd - wildcardImports.begin());
+
+            // Searching each imported package is expensive when the same names are looked
+            // up over and over, so results (including failures to find anything) are
+            // remembered for the set of imports that are visible from this location.
+            Scope::WildcardImportData::ResolvedName resolved;
+            auto& resolvedNames = wildcardImportData->resolvedNames;
+            if (auto it = resolvedNames.find({name, numVisible}); it != resolvedNames.end()) {
+                resolved = it->second;
+            }
+            else {
+                struct Import {
+                    const Symbol* imported;
+                    const WildcardImportSymbol* import;
+                };
+                SmallVector<Import, 4> imports;
+                SmallSet<const Symbol*, 2> importDedup;
+                bool cacheable = true;
+
+                for (size_t i = 0; i < numVisible; i++) {
+                    auto import = wildcardImports[i];
+                    auto package = import->getPackage();
+                    if (!package) {
+                        resolved.suppressUndeclared = true;
+                        continue;
+                    }
 
-            for (auto import : wildcardImportData->wildcardImports) {
-                if (location < LookupLocation::after(*import))
-                    break;
+                    // Packages with export declarations can grow their set of exported
+                    // names as they are elaborated, so lookups in them aren't cached.
+                    if (package->hasExportAll || !package->exportDecls.empty())
+                        cacheable = false;
 
-                auto package = import->getPackage();
-                if (!package) {
-                    result.flags |= LookupResultFlags::SuppressUndeclared;
-                    continue;
+                    const Symbol* imported = package->findForImport(name);
+                    if (imported && importDedup.emplace(imported).second)
+                        imports.emplace_back(Import{imported, import});
                 }
 
-                const Symbol* imported = package->findForImport(name);
-                if (imported && importDedup.emplace(imported).second)
-                    imports.emplace_back(Import{imported, import});
-            }
-
-            if (!imports.empty()) {
                 if (imports.size() > 1) {
+                    if (resolved.suppressUndeclared)
+                        result.flags |= LookupResultFlags::SuppressUndeclared;
+
                     if (sourceRange) {
                         auto& diag = result.addDiag(scope, diag::AmbiguousWildcardImport,
                                                     *sourceRange);
@@ -1883,24 +1957,41 @@ void Lookup::unqualifiedImpl(const Scope& scope, std::string_view name, LookupLo
                     return;
                 }
 
+                if (!imports.empty()) {
+                    resolved.symbol = imports[0].imported;
+                    resolved.import = imports[0].import;
+                }
+
+                if (cacheable) {
+                    // The name may not outlive this call so make a copy for the key.
+                    auto nameCopy = scope.getCompilation().copyFrom(std::span(name));
+                    resolvedNames.emplace(
+                        std::tuple(std::string_view(nameCopy.data(), nameCopy.size()), numVisible),
+                        resolved);
+                }
+            }
+
+            if (resolved.suppressUndeclared)
+                result.flags |= LookupResultFlags::SuppressUndeclared;
+
+            if (resolved.symbol) {
                 if (symbol && sourceRange) {
                     // The existing symbol might be an import for the thing we just imported
                     // via wildcard, which is fine so don't error for that case.
                     if (symbol->kind != SymbolKind::ExplicitImport ||
-                        symbol->as<ExplicitImportSymbol>().importedSymbol() !=
-                            imports[0].imported) {
+                        symbol->as<ExplicitImportSymbol>().importedSymbol() != resolved.symbol) {
 
                         auto& diag = result.addDiag(scope, diag::ImportNameCollision, *sourceRange);
                         diag << name;
                         diag.addNote(diag::NoteDeclarationHere, symbol->location);
-                        diag.addNote(diag::NoteImportedFrom, imports[0].import->location);
-                        diag.addNote(diag::NoteDeclarationHere, imports[0].imported->location);
+                        diag.addNote(diag::NoteImportedFrom, resolved.import->location);
+                        diag.addNote(diag::NoteDeclarationHere, resolved.symbol->location);
                     }
                 }
 
                 result.flags |= LookupResultFlags::WasImported;
-                result.found = imports[0].imported;
-                scope.getCompilation().noteReference(*imports[0].import);
+                result.found = resolved.symbol;
+                scope.getCompilation().noteReference(*resolved.import);
 
                 wildcardImportData->importedSymbols.try_emplace(result.found->name, result.found);
                 return;
@@ -2206,17 +2297,70 @@ void Lookup::reportUndeclared(const Scope& initialScope, std::string_view name,
         // disabled by config or if we've tried too many times to correct typos.
         if (comp.doTypoCorrection()) {
             auto checkMembers = [&](const Scope& toCheck) {
-                for (auto& member : toCheck.members()) {
-                    if (member.name.empty() || !isViable(member))
-                        continue;
+                // A correction is only suggested if it's within a third of the length
+                // of the name, and it must also beat anything found in previous scopes.
+                const int bound = std::min(bestDistance - 1, int(name.length() / 3));
+                if (bound < 0)
+                    return;
 
-                    int dist = editDistance(member.name, name, /* allowReplacements */ true,
-                                            bestDistance);
-                    if (dist < bestDistance) {
-                        closestSym = &member;
-                        bestDistance = dist;
+                // The edit distance is at least the difference in length of the two
+                // names, so we only need to look at members with names close in length.
+                // Those are found via an index of members bucketed by name length, built
+                // the first time the scope is checked and discarded by the scope if its
+                // members change after that.
+                auto members = toCheck.members();
+                auto& index = comp.typoIndexMap[&toCheck];
+                if (index.byLength.empty()) {
+                    uint32_t ordinal = 0;
+                    for (auto& member : members) {
+                        auto len = member.name.length();
+                        if (len == 0)
+                            continue;
+
+                        if (len >= index.byLength.size())
+                            index.byLength.resize(len + 1);
+                        index.byLength[len].emplace_back(ordinal++, &member);
                     }
                 }
+
+                // Find the closest viable member, preferring the earliest
+                // declared one when there are ties, as a linear scan would.
+                const Symbol* found = nullptr;
+                int foundDist = bound;
+                uint32_t foundOrdinal = 0;
+
+                const int nameLen = int(name.length());
+                const int maxLen = std::min(nameLen + bound, int(index.byLength.size()) - 1);
+                for (int len = std::max(nameLen - bound, 1); len <= maxLen; len++) {
+                    const int lenDiff = std::abs(len - nameLen);
+                    for (auto [ordinal, member] : index.byLength[size_t(len)]) {
+                        if (found && (lenDiff > foundDist ||
+                                      (lenDiff == foundDist && ordinal > foundOrdinal))) {
+                            continue;
+                        }
+
+                        // Note that a max distance of zero means unbounded,
+                        // which is fine since we check the result anyway.
+                        int dist = editDistance(member->name, name, /* allowReplacements */ true,
+                                                foundDist);
+                        if (dist > foundDist)
+                            continue;
+
+                        if (found && dist == foundDist && ordinal > foundOrdinal)
+                            continue;
+
+                        if (isViable(*member)) {
+                            found = member;
+                            foundDist = dist;
+                            foundOrdinal = ordinal;
+                        }
+                    }
+                }
+
+                if (found) {
+                    closestSym = found;
+                    bestDistance = foundDist;
+                }
             };
 
             // Check the current scope.
@@ -152,10 +152,16 @@ bool Scope::isUninstantiated() const {
 }
 
 Diagnostic& Scope::addDiag(DiagCode code, SourceLocation location) const {
+    if (auto filtered = compilation.filterDiag(code, location))
+        return *filtered;
+
     return compilation.addDiag(Diagnostic(*thisSym, code, location));
 }
 
 Diagnostic& Scope::addDiag(DiagCode code, SourceRange sourceRange) const {
+    if (auto filtered = compilation.filterDiag(code, sourceRange.start()))
+        return *filtered;
+
     Diagnostic diag(*thisSym, code, sourceRange.start());
     diag << sourceRange;
     return compilation.addDiag(std::move(diag));
@@ -163,6 +169,9 @@ Diagnostic& Scope::addDiag(DiagCode code, SourceRange sourceRange) const {
 
 void Scope::addDiags(const Diagnostics& diags) const {
     for (auto& diag : diags) {
+        if (compilation.filterDiag(diag.code, diag.location))
+            continue;
+
         Diagnostic copy = diag;
         copy.symbol = thisSym;
         compilation.addDiag(copy);
@@ -633,6 +642,8 @@ void Scope::insertMember(const Symbol* member, const Symbol* at, bool isElaborat
     if (!member->nextInScope)
         lastMember = member;
 
+    invalidateTypoIndex();
+
     // Add to the name map if the symbol has a name and can be looked up
     // by name in the default namespace.
     if (!member->name.empty() && canLookupByName(member->kind)) {
@@ -642,6 +653,12 @@ void Scope::insertMember(const Symbol* member, const Symbol* at, bool isElaborat
     }
 }
 
+void Scope::invalidateTypoIndex() const {
+    // Typo correction is rare so the map is almost always empty.
+    if (!compilation.typoIndexMap.empty())
+        compilation.typoIndexMap.erase(this);
+}
+
 void Scope::handleNameConflict(const Symbol& member, const Symbol*& existing,
                                bool isElaborating) const {
     // We have a name collision; first check if this is ok (forwarding typedefs share a
@@ -1200,6 +1217,8 @@ void Scope::elaborate() const {
 
                 if (lastMember == symbol)
                     lastMember = symbol->nextInScope;
+
+                invalidateTypoIndex();
             }
             else {
                 prev = symbol;
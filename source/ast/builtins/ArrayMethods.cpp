@@ -63,7 +63,7 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo& callInfo) const final {
-        ConstantValue arr = args[0]->eval(context);
+        const ConstantValue arr = args[0]->eval(context);
         if (!arr)
             return nullptr;
 
@@ -185,7 +185,7 @@ public:
                 sortTarget(*target->queue());
             }
             else {
-                auto& vec = std::get<ConstantValue::Elements>(target->getVariant());
+                auto& vec = *std::get<ConstantValue::ElementsPtr>(target->getVariant());
                 sortTarget(vec);
             }
         }
@@ -201,7 +201,7 @@ public:
                 sortTarget(*target->queue());
             }
             else {
-                auto& vec = std::get<ConstantValue::Elements>(target->getVariant());
+                auto& vec = *std::get<ConstantValue::ElementsPtr>(target->getVariant());
                 sortTarget(vec);
             }
         }
@@ -242,7 +242,7 @@ public:
         if (target->isQueue())
             std::ranges::reverse(*target->queue());
         else
-            std::ranges::reverse(std::get<ConstantValue::Elements>(target->getVariant()));
+            std::ranges::reverse(*std::get<ConstantValue::ElementsPtr>(target->getVariant()));
 
         return nullptr;
     }
@@ -290,7 +290,7 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo& callInfo) const final {
-        ConstantValue arr = args[0]->eval(context);
+        const ConstantValue arr = args[0]->eval(context);
         if (!arr)
             return nullptr;
 
@@ -355,7 +355,7 @@ public:
             if (arr.isQueue())
                 find(*arr.queue());
             else
-                find(std::get<ConstantValue::Elements>(arr.getVariant()));
+                find(*std::get<ConstantValue::ElementsPtr>(arr.getVariant()));
         }
 
         return results;
@@ -394,7 +394,7 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo& callInfo) const final {
-        ConstantValue arr = args[0]->eval(context);
+        const ConstantValue arr = args[0]->eval(context);
         if (!arr)
             return nullptr;
 
@@ -485,7 +485,7 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo& callInfo) const final {
-        ConstantValue arr = args[0]->eval(context);
+        const ConstantValue arr = args[0]->eval(context);
         if (!arr)
             return nullptr;
 
@@ -1009,7 +1009,7 @@ public:
 
     ConstantValue eval(EvalContext& context, const Args& args, SourceRange,
                        const CallExpression::SystemCallInfo& callInfo) const final {
-        ConstantValue arr = args[0]->eval(context);
+        const ConstantValue arr = args[0]->eval(context);
         if (!arr)
             return nullptr;
 
@@ -1050,7 +1050,7 @@ public:
             }
             else {
                 ConstantValue::Elements results;
-                if (!doMap(std::get<ConstantValue::Elements>(arr.getVariant()), results))
+                if (!doMap(*std::get<ConstantValue::ElementsPtr>(arr.getVariant()), results))
                     return nullptr;
                 return results;
             }
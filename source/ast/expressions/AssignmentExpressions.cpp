@@ -311,7 +311,7 @@ Expression* Expression::tryConnectPortArray(const ASTContext& context, const Typ
             auto& unpackedType = FixedSizeUnpackedArrayType::fromDims(*context.scope, *ct,
                                                                       unpackedDims,
                                                                       expr.sourceRange);
-            if (!portType.isEquivalent(unpackedType)) {
+            if (!comp.checkTypeRelation(portType, unpackedType, TypeRelation::Equivalent)) {
                 return bad();
             }
 
@@ -323,7 +323,8 @@ Expression* Expression::tryConnectPortArray(const ASTContext& context, const Typ
         // If there are no instance dims left, just make sure the remaining type matches
         // the port and we're good to go.
         if (instanceDims.empty())
-            return portType.isEquivalent(*ct) ? result : bad();
+            return comp.checkTypeRelation(portType, *ct, TypeRelation::Equivalent) ? result
+                                                                                   : bad();
 
         // Otherwise, if there are instance dimemsions left there needs to be packed dimensions
         // in the connection to match up with them.
@@ -378,7 +379,7 @@ Expression* Expression::tryConnectPortArray(const ASTContext& context, const Typ
 }
 
 bool Expression::isImplicitlyAssignableTo(Compilation& compilation, const Type& targetType) const {
-    if (targetType.isAssignmentCompatible(*type))
+    if (compilation.checkTypeRelation(targetType, *type, TypeRelation::AssignmentCompatible))
         return true;
 
     // String literals have a type of integer, but are allowed to implicitly convert to the
@@ -416,7 +417,7 @@ Expression& Expression::convertAssignment(const ASTContext& context, const Type&
         contextDetermined(context, result, nullptr, t, assignmentRange, /* isAssignment */ true);
     };
 
-    if (type.isEquivalent(*rt)) {
+    if (comp.checkTypeRelation(type, *rt, TypeRelation::Equivalent)) {
         finalizeType(*rt);
 
         if (type.isVoid())
@@ -424,7 +425,8 @@ Expression& Expression::convertAssignment(const ASTContext& context, const Type&
 
         // If the types are not actually matching we might still want
         // to issue conversion warnings.
-        if (!context.inUnevaluatedBranch() && !type.isMatching(*rt)) {
+        if (!context.inUnevaluatedBranch() &&
+            !comp.checkTypeRelation(type, *rt, TypeRelation::Matching)) {
             checkImplicitConversions(context, *rt, type, *result, nullptr, assignmentRange,
                                      ConversionKind::Implicit);
         }
@@ -439,7 +441,8 @@ Expression& Expression::convertAssignment(const ASTContext& context, const Type&
         // If the connection is already of the right size and simply differs in
         // terms of four-statedness or signedness, don't bother trying to slice
         // out the connection.
-        if (type.getBitWidth() != rt->getBitWidth() || !type.isAssignmentCompatible(*rt)) {
+        if (type.getBitWidth() != rt->getBitWidth() ||
+            !comp.checkTypeRelation(type, *rt, TypeRelation::AssignmentCompatible)) {
             // If we have an lhsExpr here, this is an output (or inout) port being connected.
             // We need to pass the lhs in as the expression to be connected, since we can't
             // slice the port side. If lhsExpr is null, this is an input port and we should
@@ -468,7 +471,7 @@ Expression& Expression::convertAssignment(const ASTContext& context, const Type&
         }
     }
 
-    if (!type.isAssignmentCompatible(*rt)) {
+    if (!comp.checkTypeRelation(type, *rt, TypeRelation::AssignmentCompatible)) {
         if (expr.isImplicitlyAssignableTo(comp, type)) {
             return ConversionExpression::makeImplicit(context, type, ConversionKind::Implicit,
                                                       *result, nullptr, assignmentRange);
@@ -507,7 +510,8 @@ Expression& Expression::convertAssignment(const ASTContext& context, const Type&
 
         DiagCode code = diag::BadAssignment;
         if (!context.flags.has(ASTFlags::OutputArg) &&
-            (type.isCastCompatible(*rt) || type.isBitstreamCastable(*rt))) {
+            (comp.checkTypeRelation(type, *rt, TypeRelation::CastCompatible) ||
+             type.isBitstreamCastable(*rt))) {
             code = diag::NoImplicitConversion;
         }
 
@@ -535,7 +539,7 @@ Expression& Expression::convertAssignment(const ASTContext& context, const Type&
         //      initial b = a;
         // will still result in an appropriate conversion warning because the type propagation
         // visitor will see that we're in an assignment and insert an implicit conversion for us.
-        if (type.isEquivalent(*rt)) {
+        if (comp.checkTypeRelation(type, *rt, TypeRelation::Equivalent)) {
             finalizeType(type);
             return *result;
         }
@@ -828,7 +832,7 @@ Expression& ConversionExpression::fromSyntax(Compilation& comp, const CastExpres
         return comp.emplace<ConversionExpression>(*type, cast, *operand, syntax.sourceRange());
     };
 
-    if (!type->isCastCompatible(*operand->type)) {
+    if (!comp.checkTypeRelation(*type, *operand->type, TypeRelation::CastCompatible)) {
         if (!Bitstream::checkClassAccess(*type, context, targetExpr.sourceRange)) {
             return badExpr(comp, result());
         }
@@ -858,7 +862,7 @@ Expression& ConversionExpression::fromSyntax(Compilation& comp, const CastExpres
     // We have a useless cast if the type of the operand matches what we're casting to, unless:
     // - We needed the assignment-like context of the cast (like for an unpacked array concat)
     // - We weren't already in an assignment-like context of the correct type
-    if (type->isMatching(*operand->type) &&
+    if (comp.checkTypeRelation(*type, *operand->type, TypeRelation::Matching) &&
         ((assignmentTarget && assignmentTarget->isMatching(*type)) ||
          !actuallyNeededCast(*type, *operand))) {
         context.addDiag(diag::UselessCast, syntax.apostrophe.location())
@@ -260,7 +260,7 @@ ConstantValue UnboundedLiteral::evalImpl(EvalContext& context) const {
 }
 
 StringLiteral::StringLiteral(const Type& type, std::string_view value, std::string_view rawValue,
-                             ConstantValue& intVal, SourceRange sourceRange) :
+                             const ConstantValue& intVal, SourceRange sourceRange) :
     Expression(ExpressionKind::StringLiteral, type, sourceRange), value(value), rawValue(rawValue),
     intStorage(&intVal) {
 }
@@ -271,7 +271,7 @@ Expression& StringLiteral::fromSyntax(const ASTContext& context,
 
     std::string_view value = syntax.literal.valueText();
     bitwidth_t width;
-    ConstantValue* intVal;
+    const ConstantValue* intVal;
 
     auto& comp = context.getCompilation();
     if (value.empty()) {
@@ -223,7 +223,7 @@ bool ElementSelectExpression::isConstantSelect(EvalContext& context) const {
 }
 
 ConstantValue ElementSelectExpression::evalImpl(EvalContext& context) const {
-    ConstantValue cv = value().eval(context);
+    const ConstantValue cv = value().eval(context);
     if (!cv)
         return nullptr;
 
@@ -268,7 +268,7 @@ ConstantValue ElementSelectExpression::evalImpl(EvalContext& context) const {
     if (valType.isString())
         return cv.getSlice(range->left, range->right, nullptr);
 
-    return std::move(cv).at(size_t(range->left));
+    return cv.at(size_t(range->left));
 }
 
 LValue ElementSelectExpression::evalLValueImpl(EvalContext& context) const {
@@ -1219,7 +1219,7 @@ static bool checkPackedUnionTag(const Type& valueType, const SVInt& val, uint32_
 }
 
 ConstantValue MemberAccessExpression::evalImpl(EvalContext& context) const {
-    ConstantValue cv = value().eval(context);
+    const ConstantValue cv = value().eval(context);
     if (!cv)
         return nullptr;
 
@@ -261,8 +261,25 @@ DefinitionSymbol::DefinitionSymbol(const Scope& scope, LookupLocation lookupLoca
     defaultNetType(defaultNetType), unconnectedDrive(unconnectedDrive), syntaxTree(syntaxTree),
     sourceLibrary(getLibForDef(scope, syntaxTree)) {
 
-    // Extract and save various properties of the definition.
     setParent(scope, lookupLocation.getIndex());
+    deferredBody = syntaxTree && syntaxTree->getMetadata().deferredBodies.contains(&syntax);
+    initFromSyntax(scope, syntax, directiveTimeScale);
+}
+
+void DefinitionSymbol::setParsedBody(const ModuleDeclarationSyntax& syntax,
+                                     std::optional<TimeScale> directiveTimeScale) {
+    SLANG_ASSERT(deferredBody);
+    deferredBody = false;
+
+    parameters.clear();
+    modports.clear();
+    timeScale.reset();
+    initFromSyntax(*getParentScope(), syntax, directiveTimeScale);
+}
+
+void DefinitionSymbol::initFromSyntax(const Scope& scope, const ModuleDeclarationSyntax& syntax,
+                                      std::optional<TimeScale> directiveTimeScale) {
+    // Extract and save various properties of the definition.
     setSyntax(syntax);
     setAttributes(scope, syntax.attributes);
 
@@ -10,7 +10,9 @@
 #include "slang/ast/ASTSerializer.h"
 #include "slang/ast/Compilation.h"
 #include "slang/ast/Expression.h"
+#include "slang/ast/expressions/AssignmentExpressions.h"
 #include "slang/ast/expressions/MiscExpressions.h"
+#include "slang/ast/expressions/OperatorExpressions.h"
 #include "slang/ast/symbols/InstanceSymbols.h"
 #include "slang/ast/symbols/PortSymbols.h"
 #include "slang/ast/symbols/SpecifySymbols.h"
@@ -143,18 +145,7 @@ const ConstantValue& ParameterSymbol::getValue(SourceRange referencingRange) con
         // from our initializer.
         auto init = getInitializer();
         if (init) {
-            value = scope->getCompilation().allocConstant(
-                ctx.eval(*init, EvalFlags::AllowUnboundedPlaceholder));
-
-            // If this parameter has an implicit type declared and it was assigned
-            // a string literal, make a note so that this parameter gets treated
-            // as an implicit string itself in further expressions.
-            auto typeSyntax = getDeclaredType()->getTypeSyntax();
-            if (typeSyntax && typeSyntax->kind == SyntaxKind::ImplicitType) {
-                auto& its = typeSyntax->as<ImplicitTypeSyntax>();
-                if (!its.signing && its.dimensions.empty())
-                    fromStringLit = init->isImplicitString();
-            }
+            setInitializerValue(ctx.eval(*init, EvalFlags::AllowUnboundedPlaceholder));
         }
         else {
             value = &ConstantValue::Invalid;
@@ -171,6 +162,85 @@ const ConstantValue& ParameterSymbol::getValue(SourceRange referencingRange) con
     return *value;
 }
 
+// Checks whether the given expression can be evaluated without referring to any
+// other symbols or looking at anything in the AST that might be lazily computed,
+// which makes it safe to evaluate concurrently with other such expressions.
+static bool isSelfContained(const Expression& expr) {
+    auto& type = *expr.type;
+    if (!type.isIntegral() && !type.isFloating() && !type.isString())
+        return false;
+
+    switch (expr.kind) {
+        case ExpressionKind::IntegerLiteral:
+        case ExpressionKind::RealLiteral:
+        case ExpressionKind::TimeLiteral:
+        case ExpressionKind::UnbasedUnsizedIntegerLiteral:
+        case ExpressionKind::StringLiteral:
+            return true;
+        case ExpressionKind::UnaryOp: {
+            auto& unary = expr.as<UnaryExpression>();
+            switch (unary.op) {
+                case UnaryOperator::Preincrement:
+                case UnaryOperator::Predecrement:
+                case UnaryOperator::Postincrement:
+                case UnaryOperator::Postdecrement:
+                    return false;
+                default:
+                    return isSelfContained(unary.operand());
+            }
+        }
+        case ExpressionKind::BinaryOp: {
+            auto& binary = expr.as<BinaryExpression>();
+            return isSelfContained(binary.left()) && isSelfContained(binary.right());
+        }
+        case ExpressionKind::ConditionalOp: {
+            auto& cond = expr.as<ConditionalExpression>();
+            for (auto& c : cond.conditions) {
+                if (c.pattern || !isSelfContained(*c.expr))
+                    return false;
+            }
+            return isSelfContained(cond.left()) && isSelfContained(cond.right());
+        }
+        case ExpressionKind::Conversion:
+            return isSelfContained(expr.as<ConversionExpression>().operand());
+        case ExpressionKind::MinTypMax: {
+            auto& mtm = expr.as<MinTypMaxExpression>();
+            return isSelfContained(mtm.min()) && isSelfContained(mtm.typ()) &&
+                   isSelfContained(mtm.max());
+        }
+        default:
+            return false;
+    }
+}
+
+const Expression* ParameterSymbol::getSelfContainedInitializer() const {
+    if (value || evaluating)
+        return nullptr;
+
+    auto init = getInitializer();
+    if (!init || init->bad() || !isSelfContained(*init))
+        return nullptr;
+
+    return init;
+}
+
+void ParameterSymbol::setInitializerValue(ConstantValue newValue) const {
+    auto init = getInitializer();
+    SLANG_ASSERT(init);
+
+    value = getParentScope()->getCompilation().allocConstant(std::move(newValue));
+
+    // If this parameter has an implicit type declared and it was assigned
+    // a string literal, make a note so that this parameter gets treated
+    // as an implicit string itself in further expressions.
+    auto typeSyntax = getDeclaredType()->getTypeSyntax();
+    if (typeSyntax && typeSyntax->kind == SyntaxKind::ImplicitType) {
+        auto& its = typeSyntax->as<ImplicitTypeSyntax>();
+        if (!its.signing && its.dimensions.empty())
+            fromStringLit = init->isImplicitString();
+    }
+}
+
 bool ParameterSymbol::isImplicitString(SourceRange referencingRange) const {
     if (!value) {
         getValue(referencingRange);
@@ -470,21 +540,21 @@ const ConstantValue& SpecparamSymbol::getValue(SourceRange referencingRange) con
         // from our initializer.
         auto init = getInitializer();
         if (init) {
-            auto& comp = scope->getCompilation();
-            value1 = comp.allocConstant(ctx.eval(*init));
-
             // Specparams can also be a "PATHPULSE$" which has two values to bind.
             auto syntax = getSyntax();
             SLANG_ASSERT(syntax);
 
             auto& decl = syntax->as<SpecparamDeclaratorSyntax>();
             if (auto exprSyntax = decl.value2) {
+                auto& comp = scope->getCompilation();
+                value1 = comp.allocConstant(ctx.eval(*init));
+
                 auto& expr2 = Expression::bindRValue(getType(), *exprSyntax, decl.equals.range(),
                                                      ctx);
                 value2 = comp.allocConstant(ctx.eval(expr2));
             }
             else {
-                value2 = &ConstantValue::Invalid;
+                setInitializerValue(ctx.eval(*init));
             }
         }
         else {
@@ -495,6 +565,26 @@ const ConstantValue& SpecparamSymbol::getValue(SourceRange referencingRange) con
     return *value1;
 }
 
+const Expression* SpecparamSymbol::getSelfContainedInitializer() const {
+    if (value1 || evaluating)
+        return nullptr;
+
+    auto syntax = getSyntax();
+    if (!syntax || syntax->as<SpecparamDeclaratorSyntax>().value2)
+        return nullptr;
+
+    auto init = getInitializer();
+    if (!init || init->bad() || !isSelfContained(*init))
+        return nullptr;
+
+    return init;
+}
+
+void SpecparamSymbol::setInitializerValue(ConstantValue newValue) const {
+    value1 = getParentScope()->getCompilation().allocConstant(std::move(newValue));
+    value2 = &ConstantValue::Invalid;
+}
+
 const ConstantValue& SpecparamSymbol::getPulseRejectLimit() const {
     SLANG_ASSERT(isPathPulse);
     getValue();
@@ -1739,8 +1739,8 @@ const Expression* PortConnection::getExpression() const {
             if (direction == ArgumentDirection::Out)
                 assignFlags = AssignFlags::OutputPort;
 
-            if (!e->type->isEquivalent(*type)) {
-                auto& comp = context.getCompilation();
+            auto& comp = context.getCompilation();
+            if (!comp.checkTypeRelation(*e->type, *type, TypeRelation::Equivalent)) {
                 auto exprType = e->type;
                 if (direction == ArgumentDirection::In) {
                     e = &Expression::convertAssignment(context, *type, *e, implicitNameRange);
@@ -1848,7 +1848,8 @@ void PortConnection::checkSimulatedNetTypes() const {
         }
 
         auto [direction, type] = getDirAndType(port);
-        if (!type->isMatching(*exprType)) {
+        if (!scope->getCompilation().checkTypeRelation(*type, *exprType,
+                                                       TypeRelation::Matching)) {
             // If this is from an interconnect connection, don't require matching types.
             auto isInterconnect = [](const Type& t) {
                 auto curr = &t;
@@ -11,6 +11,7 @@
 #include "slang/ast/ASTVisitor.h"
 #include "slang/ast/Compilation.h"
 #include "slang/ast/expressions/MiscExpressions.h"
+#include "slang/ast/symbols/BlockSymbols.h"
 #include "slang/ast/symbols/ClassSymbols.h"
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
 #include "slang/ast/symbols/InstanceSymbols.h"
@@ -28,6 +29,20 @@ namespace slang::ast {
 using namespace parsing;
 using namespace syntax;
 
+void SubroutineSymbol::collectLocalSlots(const Scope& scope,
+                                         SmallVectorBase<const VariableSymbol*>& slots) {
+    for (auto& member : scope.members()) {
+        if (VariableSymbol::isKind(member.kind)) {
+            auto& var = member.as<VariableSymbol>();
+            var.frameSlot = uint32_t(slots.size());
+            slots.push_back(&var);
+        }
+        else if (member.kind == SymbolKind::StatementBlock) {
+            collectLocalSlots(member.as<StatementBlockSymbol>(), slots);
+        }
+    }
+}
+
 const Statement& SubroutineSymbol::getBody() const {
     if (!stmt) {
         auto syntax = getSyntax();
@@ -55,6 +70,12 @@ const Statement& SubroutineSymbol::getBody() const {
             stmt = &Statement::bindItems(syntax->as<FunctionDeclarationSyntax>().items, context,
                                          stmtCtx);
         }
+
+        // All locals, including those in nested blocks, exist now that the
+        // body has been bound, so give each of them its frame slot.
+        SmallVector<const VariableSymbol*> slots;
+        collectLocalSlots(*this, slots);
+        localSlots = slots.copy(getCompilation());
     }
     return *stmt;
 }
@@ -749,6 +770,11 @@ bool SubroutineSymbol::hasOutputArgs() const {
     return *cachedHasOutputArgs;
 }
 
+std::span<const VariableSymbol* const> SubroutineSymbol::getLocalSlots() const {
+    getBody();
+    return localSlots;
+}
+
 void SubroutineSymbol::connectExternInterfacePrototype() const {
     if (prototype)
         return;
@@ -670,11 +670,7 @@ const Type& PackedArrayType::fromDim(const Scope& scope, const Type& elementType
         return comp.getErrorType();
     }
 
-    auto result = comp.emplace<PackedArrayType>(elementType, dim, bitwidth_t(*width));
-    if (auto syntax = sourceRange.syntax())
-        result->setSyntax(*syntax);
-
-    return *result;
+    return comp.getPackedArrayType(elementType, dim, sourceRange.syntax());
 }
 
 FixedSizeUnpackedArrayType::FixedSizeUnpackedArrayType(const Type& elementType, ConstantRange range,
@@ -711,12 +707,7 @@ const Type& FixedSizeUnpackedArrayType::fromDim(const Scope& scope, const Type&
         return comp.getErrorType();
     }
 
-    auto result = comp.emplace<FixedSizeUnpackedArrayType>(elementType, dim, *selectableWidth,
-                                                           *bitstreamWidth);
-    if (auto syntax = sourceRange.syntax())
-        result->setSyntax(*syntax);
-
-    return *result;
+    return comp.getUnpackedArrayType(elementType, dim, sourceRange.syntax());
 }
 
 ConstantValue FixedSizeUnpackedArrayType::getDefaultValueImpl() const {
@@ -404,6 +404,11 @@ bool Type::isTaggedUnion() const {
 
 bool Type::isMatching(const Type& rhs) const {
     // See [6.22.1] for Matching Types.
+    // Identical types (which includes interned array types built from
+    // the same element type and range) can skip canonicalization entirely.
+    if (this == &rhs)
+        return true;
+
     const Type* l = &getCanonicalType();
     const Type* r = &rhs.getCanonicalType();
 
@@ -498,6 +503,9 @@ bool Type::isMatching(const Type& rhs) const {
 
 bool Type::isEquivalent(const Type& rhs) const {
     // See [6.22.2] for Equivalent Types
+    if (this == &rhs)
+        return true;
+
     const Type* l = &getCanonicalType();
     const Type* r = &rhs.getCanonicalType();
     if (l->isMatching(*r))
@@ -567,6 +575,9 @@ bool Type::isEquivalent(const Type& rhs) const {
 
 bool Type::isAssignmentCompatible(const Type& rhs) const {
     // See [6.22.3] for Assignment Compatible
+    if (this == &rhs)
+        return true;
+
     const Type* l = &getCanonicalType();
     const Type* r = &rhs.getCanonicalType();
     if (l->isEquivalent(*r))
@@ -914,7 +925,7 @@ static const Type* changeSign(Compilation& compilation, const Type& type, bool s
     for (size_t i = 0; i < count; i++) {
         // There's no worry about size overflow here because we started with a valid type.
         ConstantRange dim = dims[count - i - 1];
-        curr = compilation.emplace<PackedArrayType>(*curr, dim, curr->getBitWidth() * dim.width());
+        curr = &compilation.getPackedArrayType(*curr, dim);
     }
 
     return curr;
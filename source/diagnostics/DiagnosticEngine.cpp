@@ -128,8 +128,10 @@ void DiagnosticEngine::clearMappings(DiagnosticSeverity severity) {
 std::error_code DiagnosticEngine::addIgnorePaths(std::string_view pattern) {
     std::error_code ec;
     auto p = fs::weakly_canonical(pattern, ec);
-    if (!ec)
+    if (!ec) {
         ignoreWarnPatterns.emplace_back(std::move(p));
+        ignoredBufferCache.clear();
+    }
 
     return ec;
 }
@@ -143,6 +145,36 @@ std::error_code DiagnosticEngine::addIgnoreMacroPaths(std::string_view pattern)
     return ec;
 }
 
+bool DiagnosticEngine::isSuppressed(DiagCode code, SourceLocation location) {
+    if (getSeverity(code, location) == DiagnosticSeverity::Ignored)
+        return true;
+
+    if (location == SourceLocation::NoLocation || ignoreWarnPatterns.empty() ||
+        getDefaultSeverity(code) != DiagnosticSeverity::Warning) {
+        return false;
+    }
+
+    // Walk out of macros the same way issueImpl does to find the file
+    // location that gets checked against the ignore patterns. The macro
+    // ignore patterns depend on the diagnostic's ranges so they aren't
+    // handled here; issue() will still apply them.
+    while (sourceManager.isMacroLoc(location)) {
+        if (sourceManager.isMacroArgLoc(location))
+            location = sourceManager.getOriginalLoc(location);
+        else
+            location = sourceManager.getExpansionLoc(location);
+    }
+
+    auto [it, inserted] = ignoredBufferCache.try_emplace(location.buffer(), false);
+    if (inserted) {
+        auto& path = sourceManager.getFullPath(location.buffer());
+        it->second = std::ranges::any_of(ignoreWarnPatterns, [&](auto& pattern) {
+            return svGlobMatches(path, pattern);
+        });
+    }
+    return it->second;
+}
+
 // Checks that all of the given ranges are in the same macro argument expansion as `loc`
 static bool checkMacroArgRanges(const DiagnosticEngine& engine, SourceLocation loc,
                                 std::span<const SourceRange> ranges) {
@@ -8,6 +8,7 @@
 #include "slang/diagnostics/Diagnostics.h"
 
 #include "slang/text/SourceManager.h"
+#include "slang/util/ThreadPool.h"
 
 namespace slang {
 
@@ -139,25 +140,83 @@ Diagnostic& Diagnostics::add(const ast::Symbol& source, DiagCode code, SourceRan
     return add(source, code, range.start()) << range;
 }
 
-void Diagnostics::sort(const SourceManager& sourceManager) {
-    auto compare = [&sourceManager](auto& x, auto& y) {
-        SourceLocation xl = sourceManager.getFullyExpandedLoc(x.location);
-        SourceLocation yl = sourceManager.getFullyExpandedLoc(y.location);
-
-        auto xb = sourceManager.getSortKey(xl.buffer());
-        auto yb = sourceManager.getSortKey(yl.buffer());
-        if (xb < yb)
-            return true;
-        if (xb == yb) {
-            if (xl.offset() < yl.offset())
-                return true;
-            if (xl == yl)
-                return x.code < y.code;
+namespace {
+
+struct DiagSortKey {
+    uint64_t bufferKey;
+    size_t offset;
+    DiagCode code;
+    uint32_t index;
+
+    auto operator<=>(const DiagSortKey&) const = default;
+};
+
+// Below this many diagnostics the cost of spinning up threads
+// outweighs any benefit from sorting in parallel.
+constexpr size_t MinDiagsForThreading = 16384;
+
+} // namespace
+
+void Diagnostics::sort(const SourceManager& sourceManager, uint32_t numThreads) {
+    if (size() < 2)
+        return;
+
+    // Resolving the fully expanded location of a diagnostic can require walking
+    // through several levels of macro expansion, so compute a key for each
+    // diagnostic once up front instead of on every comparison. The original index
+    // is included as the final tie-breaker so that the sort remains stable.
+    std::vector<DiagSortKey> keys(size());
+    auto computeKeys = [&](size_t from, size_t to) {
+        for (size_t i = from; i < to; i++) {
+            auto& diag = (*this)[i];
+            SourceLocation loc = sourceManager.getFullyExpandedLoc(diag.location);
+            keys[i] = {sourceManager.getSortKey(loc.buffer()), loc.offset(), diag.code,
+                       uint32_t(i)};
         }
-        return false;
     };
 
-    std::ranges::stable_sort(*this, compare);
+    if (numThreads == 1 || size() < MinDiagsForThreading) {
+        computeKeys(0, size());
+        std::ranges::sort(keys);
+    }
+    else {
+        ThreadPool threadPool(numThreads);
+        const size_t numChunks = threadPool.getThreadCount();
+        std::vector<size_t> bounds(numChunks + 1);
+        for (size_t i = 0; i <= numChunks; i++)
+            bounds[i] = i * keys.size() / numChunks;
+
+        // Compute and sort each chunk independently, then merge adjacent
+        // sorted runs pairwise until only one remains.
+        for (size_t i = 0; i < numChunks; i++) {
+            threadPool.pushTask([&, i] {
+                computeKeys(bounds[i], bounds[i + 1]);
+                std::sort(keys.begin() + ptrdiff_t(bounds[i]),
+                          keys.begin() + ptrdiff_t(bounds[i + 1]));
+            });
+        }
+        threadPool.waitForAll();
+
+        for (size_t width = 1; width < numChunks; width *= 2) {
+            for (size_t i = 0; i + width < numChunks; i += width * 2) {
+                threadPool.pushTask([&, i, width] {
+                    auto first = keys.begin() + ptrdiff_t(bounds[i]);
+                    auto middle = keys.begin() + ptrdiff_t(bounds[i + width]);
+                    auto last = keys.begin() +
+                                ptrdiff_t(bounds[std::min(i + width * 2, numChunks)]);
+                    std::inplace_merge(first, middle, last);
+                });
+            }
+            threadPool.waitForAll();
+        }
+    }
+
+    Diagnostics sorted;
+    sorted.reserve(size());
+    for (auto& key : keys)
+        sorted.emplace_back(std::move((*this)[key.index]));
+
+    *this = std::move(sorted);
 }
 
 Diagnostics Diagnostics::filter(std::initializer_list<DiagCode> list) const {
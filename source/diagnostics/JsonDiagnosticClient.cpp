@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+// JsonDiagnosticClient.cpp
+// Diagnostic client that formats to JSON Lines records
+//
+// SPDX-FileCopyrightText: Michael Popoloski
+// SPDX-License-Identifier: MIT
+//------------------------------------------------------------------------------
+#include "slang/diagnostics/JsonDiagnosticClient.h"
+
+#include "slang/text/Json.h"
+#include "slang/text/SourceManager.h"
+
+namespace slang {
+
+JsonDiagnosticClient::SymbolPathCB JsonDiagnosticClient::defaultSymbolPathCB;
+
+JsonDiagnosticClient::JsonDiagnosticClient() :
+    writer(std::make_unique<JsonWriter>()), symbolPathCB(defaultSymbolPathCB) {
+}
+
+JsonDiagnosticClient::~JsonDiagnosticClient() = default;
+
+uint32_t JsonDiagnosticClient::getFileId(SourceLocation loc) {
+    std::string_view name = sourceManager->getFileName(loc);
+    auto [it, inserted] = fileIds.try_emplace(name, uint32_t(fileIds.size()));
+    if (inserted) {
+        writer->clear();
+        writer->startObject();
+        writer->writeProperty("file");
+        writer->writeValue(uint64_t(it->second));
+        writer->writeProperty("name");
+        writer->writeValue(name);
+        writer->endObject();
+
+        buffer.append(writer->view());
+        buffer.push_back('\n');
+    }
+    return it->second;
+}
+
+void JsonDiagnosticClient::report(const ReportedDiagnostic& diag) {
+    // The file table entry, if needed, has to be written before the
+    // diagnostic record that refers to it.
+    std::optional<uint32_t> fileId;
+    if (diag.location.buffer() != SourceLocation::NoLocation.buffer())
+        fileId = getFileId(diag.location);
+
+    auto& od = diag.originalDiagnostic;
+    writer->clear();
+    writer->startObject();
+    writer->writeProperty("code");
+    writer->writeValue(toString(od.code));
+    writer->writeProperty("severity");
+    writer->writeValue(getSeverityString(diag.severity));
+
+    if (auto optionName = engine->getOptionName(od.code); !optionName.empty()) {
+        writer->writeProperty("option");
+        writer->writeValue(optionName);
+    }
+
+    if (fileId) {
+        writer->writeProperty("file");
+        writer->writeValue(uint64_t(*fileId));
+        writer->writeProperty("line");
+        writer->writeValue(uint64_t(sourceManager->getLineNumber(diag.location)));
+        writer->writeProperty("column");
+        writer->writeValue(uint64_t(sourceManager->getColumnNumber(diag.location)));
+    }
+
+    writer->writeProperty("message");
+    writer->writeValue(diag.formattedMessage);
+
+    if (!od.args.empty()) {
+        // Custom argument types are only meaningful through their registered
+        // formatters, so they're represented by the formatted message alone.
+        writer->writeProperty("args");
+        writer->startArray();
+        for (auto& arg : od.args) {
+            std::visit(
+                [&](auto&& t) {
+                    using T = std::decay_t<decltype(t)>;
+                    if constexpr (std::is_same_v<T, std::string>)
+                        writer->writeValue(std::string_view(t));
+                    else if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, uint64_t>)
+                        writer->writeValue(t);
+                    else if constexpr (std::is_same_v<T, char>)
+                        writer->writeValue(std::string_view(&t, 1));
+                    else if constexpr (std::is_same_v<T, ConstantValue>)
+                        writer->writeValue(t.toString());
+                    else
+                        writer->writeValue(std::string_view());
+                },
+                arg);
+        }
+        writer->endArray();
+    }
+
+    if (od.symbol && symbolPathCB) {
+        writer->writeProperty("hierarchy");
+        writer->writeValue(symbolPathCB(*od.symbol));
+        if (od.coalesceCount) {
+            writer->writeProperty("instances");
+            writer->writeValue(uint64_t(*od.coalesceCount));
+        }
+    }
+
+    writer->endObject();
+
+    buffer.append(writer->view());
+    buffer.push_back('\n');
+
+    if (outputSink && buffer.size() >= sinkThreshold)
+        flush();
+}
+
+void JsonDiagnosticClient::flush() {
+    if (outputSink && !buffer.empty()) {
+        outputSink(std::string_view(buffer));
+        buffer.clear();
+    }
+}
+
+void JsonDiagnosticClient::clear() {
+    buffer.clear();
+    fileIds.clear();
+}
+
+std::string JsonDiagnosticClient::getString() const {
+    return buffer;
+}
+
+} // namespace slang
@@ -101,6 +101,16 @@ void TextDiagnosticClient::report(const ReportedDiagnostic& diag) {
                        DiagnosticSeverity::Note, name, "");
         }
     }
+
+    if (outputSink && buffer->size() >= sinkThreshold)
+        flush();
+}
+
+void TextDiagnosticClient::flush() {
+    if (outputSink && !buffer->empty()) {
+        outputSink(std::string_view(buffer->data(), buffer->size()));
+        buffer->clear();
+    }
 }
 
 void TextDiagnosticClient::clear() {
@@ -189,13 +199,17 @@ static bool printableTextForNextChar(std::string_view sourceLine, size_t& index,
 }
 
 struct SourceSnippet {
-    SourceSnippet(std::string_view sourceLine, uint32_t tabStop) {
-        SLANG_ASSERT(!sourceLine.empty());
-
-        byteToColumn.resize(sourceLine.size() + 1);
-        for (size_t i = 0; i < byteToColumn.size(); i++)
-            byteToColumn[i] = -1;
-
+    // Rebuilds the snippet for the given line. Diagnostics tend to cluster on
+    // the same lines, so callers can skip this when @a sourceLine hasn't changed
+    // and just call resetHighlight instead.
+    void init(std::string_view newLine, uint32_t tabStop) {
+        SLANG_ASSERT(!newLine.empty());
+
+        sourceLine.assign(newLine);
+        byteToColumn.clear();
+        byteToColumn.resize(sourceLine.size() + 1, -1);
+        invalidRanges.clear();
+        snippetLine.clear();
         snippetLine.reserve(sourceLine.size());
 
         SmallVector<char> buffer;
@@ -214,9 +228,11 @@ struct SourceSnippet {
         }
 
         byteToColumn[sourceLine.size()] = (int)column;
-        highlightLine = std::string(column, ' ');
+        resetHighlight();
     }
 
+    void resetHighlight() { highlightLine.assign((size_t)byteToColumn.back(), ' '); }
+
     size_t getColumnForByte(size_t b) const {
         while (byteToColumn[b] == -1)
             b--;
@@ -296,6 +312,7 @@ struct SourceSnippet {
         out.append(fg(highlightColor), highlightLine);
     }
 
+    std::string sourceLine;
     SmallVector<int> byteToColumn;
     SmallVector<std::pair<size_t, size_t>, 4> invalidRanges;
     std::string snippetLine;
@@ -341,13 +358,20 @@ void TextDiagnosticClient::formatDiag(SourceLocation loc, std::span<const Source
             // We might want to make the tab width configurable at some point,
             // but for now hardcode it to 8 to match the default on basically
             // every terminal.
-            SourceSnippet snippet(line, 8);
+            if (!snippet)
+                snippet = std::make_unique<SourceSnippet>();
+
+            if (snippet->sourceLine != line)
+                snippet->init(line, 8);
+            else
+                snippet->resetHighlight();
+
             for (SourceRange range : ranges)
-                snippet.highlightRange(range, loc, col, line);
+                snippet->highlightRange(range, loc, col, line);
 
-            snippet.insertCaret(col);
-            snippet.trimHighlight();
-            snippet.printTo(*buffer, highlightColor);
+            snippet->insertCaret(col);
+            snippet->trimHighlight();
+            snippet->printTo(*buffer, highlightColor);
         }
     }
 
@@ -9,12 +9,16 @@
 #include "slang/driver/Driver.h"
 
 #include <fmt/color.h>
+#include <fstream>
+#include <map>
+#include <mutex>
 
 #include "slang/ast/Compilation.h"
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
 #include "slang/ast/symbols/InstanceSymbols.h"
 #include "slang/diagnostics/DeclarationsDiags.h"
 #include "slang/diagnostics/ExpressionsDiags.h"
+#include "slang/diagnostics/JsonDiagnosticClient.h"
 #include "slang/diagnostics/LookupDiags.h"
 #include "slang/diagnostics/ParserDiags.h"
 #include "slang/diagnostics/StatementsDiags.h"
@@ -83,6 +87,9 @@ void Driver::addStandardArgs() {
     cmdLine.add("--libraries-inherit-macros", options.librariesInheritMacros,
                 "If true, library files will inherit macro definitions from the primary source "
                 "files. --single-unit must also be passed when this option is used.");
+    cmdLine.add("--defer-library-bodies", options.deferLibraryBodies,
+                "If true, the bodies of modules, interfaces, and programs in library files "
+                "are only parsed once they are actually used in the design.");
     cmdLine.add("--enable-legacy-protect", options.enableLegacyProtect,
                 "If true, the preprocessor will support legacy protected envelope directives, "
                 "for compatibility with old Verilog tools.");
@@ -110,7 +117,8 @@ void Driver::addStandardArgs() {
                 "is skipped",
                 "<count>");
     cmdLine.add("-j,--threads", options.numThreads,
-                "The number of threads to use to parallelize parsing", "<count>");
+                "The number of threads to use to parallelize parsing and elaboration",
+                "<count>");
 
     cmdLine.add(
         "-C",
@@ -223,6 +231,10 @@ void Driver::addStandardArgs() {
                 "Show macro expansion backtraces in diagnostic output.");
     cmdLine.add("--diag-hierarchy", options.diagHierarchy,
                 "Show hierarchy locations in diagnostic output.", "always|never|auto");
+    cmdLine.add("--diag-json", options.diagJson,
+                "Additionally write diagnostics in JSON Lines format to the given file, "
+                "or to stdout if '-' is given.",
+                "<file>", CommandLineFlags::FilePath);
     cmdLine.add("--error-limit", options.errorLimit,
                 "Limit on the number of errors that will be printed. Setting this to zero will "
                 "disable the limit.",
@@ -511,6 +523,26 @@ bool Driver::processOptions() {
     else if (options.diagHierarchy == "never")
         dc.showHierarchyInstance(ShowHierarchyPathOption::Never);
 
+    if (options.diagJson.has_value()) {
+        jsonDiagClient = std::make_shared<JsonDiagnosticClient>();
+        if (*options.diagJson == "-") {
+            jsonDiagClient->setOutputSink([](std::string_view text) { OS::print(text); });
+        }
+        else {
+            auto stream = std::make_shared<std::ofstream>(*options.diagJson);
+            if (!stream->is_open()) {
+                printError(fmt::format("unable to open '{}' for writing", *options.diagJson));
+                return false;
+            }
+
+            jsonDiagClient->setOutputSink([stream](std::string_view text) {
+                stream->write(text.data(), std::streamsize(text.size()));
+                stream->flush();
+            });
+        }
+        diagEngine.addClient(jsonDiagClient);
+    }
+
     diagEngine.setErrorLimit((int)options.errorLimit.value_or(20));
     diagEngine.setDefaultWarnings();
 
@@ -562,22 +594,55 @@ static std::string generateRandomAlphanumericString(TGenerator& gen, size_t len)
     return result;
 }
 
+// Splits loaded buffers into the units that get preprocessed independently of
+// each other: every buffer is its own unit unless we're in single-unit mode.
+static std::vector<std::span<const SourceBuffer>> getPreprocessorUnits(
+    std::span<const SourceBuffer> buffers, bool singleUnit) {
+    std::vector<std::span<const SourceBuffer>> units;
+    if (singleUnit) {
+        if (!buffers.empty())
+            units.push_back(buffers);
+    }
+    else {
+        for (size_t i = 0; i < buffers.size(); i++)
+            units.push_back(buffers.subspan(i, 1));
+    }
+    return units;
+}
+
+// Returns true if preprocessing the given number of units is worth spreading
+// across a thread pool.
+static bool shouldPreprocessInParallel(size_t numUnits, std::optional<uint32_t> numThreads) {
+    static constexpr size_t MinUnitsForThreading = 4;
+    return numUnits >= MinUnitsForThreading && numThreads != 1u;
+}
+
+// Invokes @a func for each unit index, spreading the work across a thread pool
+// when there are enough units to make that worthwhile.
+template<typename TFunc>
+static void forEachPreprocessorUnit(size_t numUnits, std::optional<uint32_t> numThreads,
+                                    TFunc&& func) {
+    if (shouldPreprocessInParallel(numUnits, numThreads)) {
+        ThreadPool threadPool(numThreads.value_or(0u));
+        threadPool.pushLoop(size_t(0), numUnits, [&](size_t start, size_t end) {
+            for (size_t i = start; i < end; i++)
+                func(i);
+        });
+        threadPool.waitForAll();
+    }
+    else {
+        for (size_t i = 0; i < numUnits; i++)
+            func(i);
+    }
+}
+
 bool Driver::runPreprocessor(bool includeComments, bool includeDirectives, bool obfuscateIds,
                              bool useFixedObfuscationSeed) {
     Bag optionBag;
     addParseOptions(optionBag);
 
-    BumpAllocator alloc;
-    Diagnostics diagnostics;
-    Preprocessor preprocessor(sourceManager, alloc, diagnostics, optionBag);
-
     auto buffers = sourceLoader.loadSources();
-    for (auto it = buffers.rbegin(); it != buffers.rend(); it++)
-        preprocessor.pushSource(*it);
-
-    SyntaxPrinter output;
-    output.setIncludeComments(includeComments);
-    output.setIncludeDirectives(includeDirectives);
+    auto units = getPreprocessorUnits(buffers, options.singleUnit == true);
 
     std::optional<std::mt19937> rng;
     flat_hash_map<std::string, std::string> obfuscationMap;
@@ -589,33 +654,86 @@ bool Driver::runPreprocessor(bool includeComments, bool includeDirectives, bool
             rng = createRandomGenerator<std::mt19937>();
     }
 
-    while (true) {
-        Token token = preprocessor.next();
-        if (token.kind == TokenKind::IntegerBase) {
-            // This is needed for the case where obfuscation is enabled,
-            // the digits of a vector literal may be lexed initially as
-            // an identifier and we don't have the parser here to fix things
-            // up for us.
-            do {
-                output.print(token);
-                token = preprocessor.next();
-            } while (SyntaxFacts::isPossibleVectorDigit(token.kind));
-        }
+    auto preprocessUnit = [&](std::span<const SourceBuffer> unitBuffers, SyntaxPrinter& output,
+                              Diagnostics& diagnostics) {
+        BumpAllocator alloc;
+        Preprocessor preprocessor(sourceManager, alloc, diagnostics, optionBag);
+        for (auto it = unitBuffers.rbegin(); it != unitBuffers.rend(); it++)
+            preprocessor.pushSource(*it);
+
+        output.setIncludeComments(includeComments);
+        output.setIncludeDirectives(includeDirectives);
+
+        while (true) {
+            Token token = preprocessor.next();
+            if (token.kind == TokenKind::IntegerBase) {
+                // This is needed for the case where obfuscation is enabled,
+                // the digits of a vector literal may be lexed initially as
+                // an identifier and we don't have the parser here to fix things
+                // up for us.
+                do {
+                    output.print(token);
+                    token = preprocessor.next();
+                } while (SyntaxFacts::isPossibleVectorDigit(token.kind));
+            }
 
-        if (obfuscateIds && token.kind == TokenKind::Identifier) {
-            auto name = std::string(token.valueText());
-            auto translation = obfuscationMap.find(name);
-            if (translation == obfuscationMap.end()) {
-                auto newName = generateRandomAlphanumericString(*rng, 16);
-                translation = obfuscationMap.emplace(name, newName).first;
+            if (obfuscateIds && token.kind == TokenKind::Identifier) {
+                auto name = std::string(token.valueText());
+                auto translation = obfuscationMap.find(name);
+                if (translation == obfuscationMap.end()) {
+                    auto newName = generateRandomAlphanumericString(*rng, 16);
+                    translation = obfuscationMap.emplace(name, newName).first;
+                }
+                token = token.withRawText(alloc, translation->second);
             }
-            token = token.withRawText(alloc, translation->second);
+
+            output.print(token);
+            if (token.kind == TokenKind::EndOfFile)
+                break;
         }
+    };
 
-        output.print(token);
-        if (token.kind == TokenKind::EndOfFile)
-            break;
-    }
+    // Obfuscation shares one identifier map across all units, so it always
+    // runs serially.
+    auto numThreads = obfuscateIds ? std::optional<uint32_t>(1u) : options.numThreads;
+    const bool parallel = shouldPreprocessInParallel(units.size(), numThreads);
+
+    // Serial output is streamed as we go so that memory use stays bounded even
+    // when preprocessing very large designs. Units preprocessed in parallel are
+    // collected and printed in their original order as soon as every unit
+    // before them has finished. Either way all of the output is printed, even
+    // if some of the units have errors.
+    SyntaxPrinter streamOutput;
+    streamOutput.setOutputSink([](std::string_view text) { OS::print(text); });
+
+    std::mutex outputMutex;
+    size_t nextUnitToPrint = 0;
+    std::vector<std::string> unitOutputs(units.size());
+    std::vector<char> unitsDone(units.size());
+    std::vector<Diagnostics> unitDiags(units.size());
+
+    forEachPreprocessorUnit(units.size(), numThreads, [&](size_t i) {
+        if (!parallel) {
+            preprocessUnit(units[i], streamOutput, unitDiags[i]);
+            return;
+        }
+
+        SyntaxPrinter output;
+        preprocessUnit(units[i], output, unitDiags[i]);
+
+        std::unique_lock lock(outputMutex);
+        unitOutputs[i] = output.str();
+        unitsDone[i] = true;
+        while (nextUnitToPrint < units.size() && unitsDone[nextUnitToPrint]) {
+            OS::print(std::exchange(unitOutputs[nextUnitToPrint], {}));
+            nextUnitToPrint++;
+        }
+    });
+    streamOutput.flush();
+
+    Diagnostics diagnostics;
+    for (auto& diags : unitDiags)
+        diagnostics.append_range(diags);
 
     // Only print diagnostics if actual errors occurred.
     for (auto& diag : diagnostics) {
@@ -625,7 +743,7 @@ bool Driver::runPreprocessor(bool includeComments, bool includeDirectives, bool
         }
     }
 
-    OS::print(fmt::format("{}\n", output.str()));
+    OS::print("\n");
     return true;
 }
 
@@ -633,21 +751,64 @@ void Driver::reportMacros() {
     Bag optionBag;
     addParseOptions(optionBag);
 
-    BumpAllocator alloc;
-    Diagnostics diagnostics;
-    Preprocessor preprocessor(sourceManager, alloc, diagnostics, optionBag);
-
     auto buffers = sourceLoader.loadSources();
-    for (auto it = buffers.rbegin(); it != buffers.rend(); it++)
-        preprocessor.pushSource(*it);
+    auto units = getPreprocessorUnits(buffers, options.singleUnit == true);
+    if (units.empty())
+        units.emplace_back();
+
+    // Each unit keeps its own allocator alive until the macros it defined
+    // have been printed.
+    std::vector<BumpAllocator> allocs(units.size());
+    std::vector<std::vector<const DefineDirectiveSyntax*>> unitMacros(units.size());
+    std::vector<std::vector<std::string_view>> unitUndefs(units.size());
+    std::vector<char> unitUndefinesAll(units.size());
+    forEachPreprocessorUnit(units.size(), options.numThreads, [&](size_t i) {
+        Diagnostics diagnostics;
+        Preprocessor preprocessor(sourceManager, allocs[i], diagnostics, optionBag);
+        for (auto it = units[i].rbegin(); it != units[i].rend(); it++)
+            preprocessor.pushSource(*it);
+
+        // Remember which macros the unit undefines, since those may have
+        // been defined by one of the units before it.
+        while (true) {
+            Token token = preprocessor.next();
+            for (auto& trivia : token.trivia()) {
+                if (trivia.kind != TriviaKind::Directive)
+                    continue;
+
+                auto syntax = trivia.syntax();
+                if (syntax->kind == SyntaxKind::UndefDirective) {
+                    unitUndefs[i].push_back(syntax->as<UndefDirectiveSyntax>().name.valueText());
+                }
+                else if (syntax->kind == SyntaxKind::UndefineAllDirective) {
+                    unitUndefs[i].clear();
+                    unitUndefinesAll[i] = true;
+                }
+            }
+
+            if (token.kind == TokenKind::EndOfFile)
+                break;
+        }
+
+        unitMacros[i] = preprocessor.getDefinedMacros();
+    });
+
+    // Merge the results in unit order, as if all of the units had gone through
+    // one preprocessor: a unit's undefines remove macros from earlier units, and
+    // its own definitions replace any earlier ones with the same name.
+    std::map<std::string_view, const DefineDirectiveSyntax*> macros;
+    for (size_t i = 0; i < units.size(); i++) {
+        if (unitUndefinesAll[i])
+            macros.clear();
+
+        for (auto name : unitUndefs[i])
+            macros.erase(name);
 
-    while (true) {
-        Token token = preprocessor.next();
-        if (token.kind == TokenKind::EndOfFile)
-            break;
+        for (auto macro : unitMacros[i])
+            macros[macro->name.valueText()] = macro;
     }
 
-    for (auto macro : preprocessor.getDefinedMacros()) {
+    for (auto [_, macro] : macros) {
         SyntaxPrinter printer;
         printer.setIncludeComments(false);
         printer.setIncludeTrivia(false);
@@ -694,6 +855,7 @@ void Driver::addParseOptions(Bag& bag) const {
     soptions.singleUnit = options.singleUnit == true;
     soptions.onlyLint = options.lintMode();
     soptions.librariesInheritMacros = options.librariesInheritMacros == true;
+    soptions.deferLibraryBodies = options.deferLibraryBodies == true;
 
     PreprocessorOptions ppoptions;
     ppoptions.predefines = options.defines;
@@ -722,10 +884,17 @@ void Driver::addParseOptions(Bag& bag) const {
     bag.set(poptions);
 }
 
+uint32_t Driver::getNumThreads() const {
+    // Work done after parsing stays on a single thread unless the
+    // user explicitly asks for more with --threads.
+    return options.numThreads.value_or(CompilationOptions{}.numThreads);
+}
+
 void Driver::addCompilationOptions(Bag& bag) const {
     CompilationOptions coptions;
     coptions.flags = CompilationFlags::None;
     coptions.languageVersion = languageVersion;
+    coptions.numThreads = getNumThreads();
     if (options.maxInstanceDepth.has_value())
         coptions.maxInstanceDepth = *options.maxInstanceDepth;
     if (options.maxGenerateSteps.has_value())
@@ -782,6 +951,13 @@ std::unique_ptr<Compilation> Driver::createCompilation() {
     defaultLib->isDefault = true;
 
     auto compilation = std::make_unique<Compilation>(createOptionBag(), defaultLib);
+
+    // Drop diagnostics the engine would ignore as soon as they're created,
+    // so that large numbers of suppressed warnings don't cost anything.
+    compilation->setDiagnosticFilter([this](DiagCode code, SourceLocation location) {
+        return diagEngine.isSuppressed(code, location);
+    });
+
     for (auto& tree : sourceLoader.getLibraryMaps())
         compilation->addSyntaxTree(tree);
     for (auto& tree : syntaxTrees)
@@ -797,15 +973,25 @@ bool Driver::reportParseDiags() {
     for (auto& tree : syntaxTrees)
         diags.append_range(tree->diagnostics());
 
-    diags.sort(sourceManager);
+    diags.sort(sourceManager, getNumThreads());
+
+    diagClient->setOutputSink([](std::string_view text) { OS::printE(text); });
     for (auto& diag : diags)
         diagEngine.issue(diag);
 
-    OS::printE(fmt::format("{}", diagClient->getString()));
+    diagClient->flush();
+    diagClient->setOutputSink(nullptr);
+    if (jsonDiagClient)
+        jsonDiagClient->flush();
     return diagEngine.getNumErrors() == 0;
 }
 
 bool Driver::reportCompilation(Compilation& compilation, bool quiet) {
+    // If JSON diagnostics are going to stdout, keep it machine readable
+    // by leaving out the human readable summary.
+    if (options.diagJson == "-")
+        quiet = true;
+
     if (!quiet) {
         auto topInstances = compilation.getRoot().topInstances;
         if (!topInstances.empty()) {
@@ -816,16 +1002,35 @@ bool Driver::reportCompilation(Compilation& compilation, bool quiet) {
         }
     }
 
-    for (auto& diag : compilation.getAllDiagnostics())
+    // Stream formatted diagnostics out as they're produced instead of
+    // holding the full text for all of them in memory. Diagnostics are sorted
+    // by file, so also flush each time we move on to a new file; that way
+    // output for a file shows up as soon as it's complete.
+    bool anyPrinted = false;
+    diagClient->setOutputSink([&](std::string_view text) {
+        OS::printE(text);
+        anyPrinted |= text.size() > 1;
+    });
+
+    BufferID lastBuffer;
+    for (auto& diag : compilation.getAllDiagnostics()) {
+        auto buffer = sourceManager.getFullyExpandedLoc(diag.location).buffer();
+        if (buffer != lastBuffer) {
+            diagClient->flush();
+            lastBuffer = buffer;
+        }
         diagEngine.issue(diag);
+    }
 
-    bool succeeded = diagEngine.getNumErrors() == 0;
+    diagClient->flush();
+    diagClient->setOutputSink(nullptr);
+    if (jsonDiagClient)
+        jsonDiagClient->flush();
 
-    std::string diagStr = diagClient->getString();
-    OS::printE(fmt::format("{}", diagStr));
+    bool succeeded = diagEngine.getNumErrors() == 0;
 
     if (!quiet) {
-        if (diagStr.size() > 1)
+        if (anyPrinted)
             OS::print("\n");
 
         if (succeeded)
@@ -837,6 +1042,11 @@ bool Driver::reportCompilation(Compilation& compilation, bool quiet) {
                               diagEngine.getNumErrors() == 1 ? "" : "s",
                               diagEngine.getNumWarnings(),
                               diagEngine.getNumWarnings() == 1 ? "" : "s"));
+
+        if (auto numFiltered = compilation.getNumFilteredDiagnostics()) {
+            OS::print(fmt::format("note: {} diagnostic{} suppressed by filter\n", numFiltered,
+                                  numFiltered == 1 ? "" : "s"));
+        }
     }
 
     return succeeded;
@@ -9,6 +9,7 @@
 
 #include <fmt/core.h>
 
+#include "slang/parsing/Parser.h"
 #include "slang/parsing/Preprocessor.h"
 #include "slang/syntax/AllSyntax.h"
 #include "slang/syntax/SyntaxTree.h"
@@ -181,6 +182,12 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
 
     auto srcOptions = optionBag.getOrDefault<SourceOptions>();
 
+    // Library files can have the bodies of their definitions skipped over
+    // until the compilation finds something that actually uses them.
+    auto libraryOptionBag = optionBag;
+    if (srcOptions.deferLibraryBodies)
+        libraryOptionBag.insertOrGet<parsing::ParserOptions>().deferModuleBodies = true;
+
     auto handleLoadResult = [&](LoadResult&& result) {
         switch (result.index()) {
             case 0:
@@ -226,7 +233,7 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
     };
 
     auto parseSeparateUnit = [&](const UnitEntry& unit, const std::vector<SourceBuffer>& buffers) {
-        auto unitOptions = optionBag;
+        auto unitOptions = unit.library ? libraryOptionBag : optionBag;
         auto& ppOptions = unitOptions.insertOrGet<parsing::PreprocessorOptions>();
         ppOptions.predefines.insert(ppOptions.predefines.end(), unit.defines.begin(),
                                     unit.defines.end());
@@ -250,7 +257,8 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
         // or via library maps.
         threadPool.pushLoop(size_t(0), fileEntries.size(), [&](size_t start, size_t end) {
             for (size_t i = start; i < end; i++)
-                loadResults[i] = loadAndParse(fileEntries[i], optionBag, srcOptions, i);
+                loadResults[i] = loadAndParse(fileEntries[i], optionBag, libraryOptionBag,
+                                               srcOptions, i);
         });
         threadPool.waitForAll();
 
@@ -287,7 +295,8 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
                                 [&](size_t start, size_t end) {
                                     for (size_t i = start; i < end; i++) {
                                         auto tree = SyntaxTree::fromBuffer(deferredLibBuffers[i],
-                                                                           sourceManager, optionBag,
+                                                                           sourceManager,
+                                                                           libraryOptionBag,
                                                                            inheritedMacros);
                                         tree->isLibraryUnit = true;
                                         syntaxTrees[i + numTrees] = std::move(tree);
@@ -300,7 +309,7 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
         // Load all source files that were specified on the command line
         // or via library maps.
         for (auto& entry : fileEntries)
-            handleLoadResult(loadAndParse(entry, optionBag, srcOptions));
+            handleLoadResult(loadAndParse(entry, optionBag, libraryOptionBag, srcOptions));
 
         parseSingleUnit(singleUnitBuffers);
 
@@ -313,7 +322,7 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
         // If we deferred libraries due to wanting to inherit macros, parse them now.
         if (!deferredLibBuffers.empty()) {
             for (auto& buffer : deferredLibBuffers) {
-                auto tree = SyntaxTree::fromBuffer(buffer, sourceManager, optionBag,
+                auto tree = SyntaxTree::fromBuffer(buffer, sourceManager, libraryOptionBag,
                                                    inheritedMacros);
                 tree->isLibraryUnit = true;
                 syntaxTrees.emplace_back(std::move(tree));
@@ -404,7 +413,7 @@ SourceLoader::SyntaxTreeList SourceLoader::loadAndParseSources(const Bag& option
                 }
 
                 if (buffer) {
-                    auto tree = SyntaxTree::fromBuffer(buffer, sourceManager, optionBag,
+                    auto tree = SyntaxTree::fromBuffer(buffer, sourceManager, libraryOptionBag,
                                                        inheritedMacros);
                     tree->isLibraryUnit = true;
                     syntaxTrees.emplace_back(tree);
@@ -523,6 +532,7 @@ void SourceLoader::createLibrary(const LibraryDeclarationSyntax& syntax, const f
 }
 
 SourceLoader::LoadResult SourceLoader::loadAndParse(const FileEntry& entry, const Bag& optionBag,
+                                                    const Bag& libraryOptionBag,
                                                     const SourceOptions& srcOptions,
                                                     uint64_t fileSortKey) {
     // TODO: error if secondLib is set
@@ -548,7 +558,8 @@ SourceLoader::LoadResult SourceLoader::loadAndParse(const FileEntry& entry, cons
     }
     else {
         // Otherwise we can parse right away.
-        auto tree = SyntaxTree::fromBuffer(*buffer, sourceManager, optionBag);
+        auto tree = SyntaxTree::fromBuffer(*buffer, sourceManager,
+                                           entry.isLibraryFile ? libraryOptionBag : optionBag);
         if (entry.isLibraryFile || srcOptions.onlyLint)
             tree->isLibraryUnit = true;
 
@@ -37,16 +37,16 @@ std::string ConstantValue::toString(bitwidth_t abbreviateThresholdBits, bool exa
                 return "null"s;
             else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                 return "$"s;
-            else if constexpr (std::is_same_v<T, Elements>) {
+            else if constexpr (std::is_same_v<T, ElementsPtr>) {
                 FormatBuffer buffer;
                 buffer.append(useAssignmentPatterns ? "'{"sv : "["sv);
-                for (auto& element : arg) {
+                for (auto& element : *arg) {
                     buffer.append(element.toString(abbreviateThresholdBits, exactUnknowns,
                                                    useAssignmentPatterns));
                     buffer.append(",");
                 }
 
-                if (!arg.empty())
+                if (!arg->empty())
                     buffer.pop_back();
                 buffer.append(useAssignmentPatterns ? "}"sv : "]"sv);
                 return buffer.str();
@@ -119,8 +119,8 @@ size_t ConstantValue::hash() const {
                 hash_combine(h, 0);
             else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                 hash_combine(h, '$');
-            else if constexpr (std::is_same_v<T, Elements>) {
-                for (auto& element : arg)
+            else if constexpr (std::is_same_v<T, ElementsPtr>) {
+                for (auto& element : *arg)
                     hash_combine(h, element.hash());
             }
             else if constexpr (std::is_same_v<T, std::string>)
@@ -159,8 +159,8 @@ size_t ConstantValue::size() const {
     return std::visit(
         [](auto&& arg) noexcept {
             using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, Elements>)
-                return arg.size();
+            if constexpr (std::is_same_v<T, ElementsPtr>)
+                return arg->size();
             else if constexpr (std::is_same_v<T, Map>)
                 return arg->size();
             else if constexpr (std::is_same_v<T, Queue>)
@@ -177,8 +177,8 @@ ConstantValue& ConstantValue::at(size_t index) {
     return std::visit(
         [index](auto&& arg) -> ConstantValue& {
             using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, Elements>)
-                return arg.at(index);
+            if constexpr (std::is_same_v<T, ElementsPtr>)
+                return arg->at(index);
             else if constexpr (std::is_same_v<T, Queue>)
                 return arg->at(index);
             else
@@ -191,8 +191,8 @@ const ConstantValue& ConstantValue::at(size_t index) const {
     return std::visit(
         [index](auto&& arg) -> const ConstantValue& {
             using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, Elements>)
-                return arg.at(index);
+            if constexpr (std::is_same_v<T, ElementsPtr>)
+                return arg->at(index);
             else if constexpr (std::is_same_v<T, Queue>)
                 return arg->at(index);
             else
@@ -286,8 +286,8 @@ bool ConstantValue::hasUnknown() const {
             if constexpr (std::is_same_v<T, SVInt>) {
                 return arg.hasUnknown();
             }
-            else if constexpr (std::is_same_v<T, Elements>) {
-                for (auto& element : arg) {
+            else if constexpr (std::is_same_v<T, ElementsPtr>) {
+                for (auto& element : *arg) {
                     if (element.hasUnknown())
                         return true;
                 }
@@ -529,11 +529,11 @@ bool operator==(const ConstantValue& lhs, const ConstantValue& rhs) {
                 return rhs.isNullHandle();
             else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                 return rhs.isUnbounded();
-            else if constexpr (std::is_same_v<T, ConstantValue::Elements>) {
+            else if constexpr (std::is_same_v<T, ConstantValue::ElementsPtr>) {
                 if (!rhs.isUnpacked())
                     return false;
 
-                return arg == std::get<ConstantValue::Elements>(rhs.value);
+                return *arg == *std::get<ConstantValue::ElementsPtr>(rhs.value);
             }
             else if constexpr (std::is_same_v<T, std::string>)
                 return rhs.isString() && arg == rhs.str();
@@ -590,11 +590,11 @@ std::partial_ordering operator<=>(const ConstantValue& lhs, const ConstantValue&
                 return unordered;
             else if constexpr (std::is_same_v<T, ConstantValue::UnboundedPlaceholder>)
                 return unordered;
-            else if constexpr (std::is_same_v<T, ConstantValue::Elements>) {
+            else if constexpr (std::is_same_v<T, ConstantValue::ElementsPtr>) {
                 if (!rhs.isUnpacked())
                     return unordered;
 
-                return arg <=> std::get<ConstantValue::Elements>(rhs.value);
+                return *arg <=> *std::get<ConstantValue::ElementsPtr>(rhs.value);
             }
             else if constexpr (std::is_same_v<T, std::string>) {
                 if (!rhs.isString())
@@ -21,6 +21,29 @@ static const double log2_10 = log2(10.0);
 
 namespace slang {
 
+// Decimal conversions work in chunks of 9 digits, since 10^9 is the largest
+// power of ten that fits in 32 bits and can be divided out of a multi-word
+// value using native 64-bit arithmetic.
+static constexpr uint32_t DecimalChunkDigits = 9;
+static constexpr uint32_t DecimalChunkDivisor = 1'000'000'000;
+
+// Values larger than these thresholds are converted by splitting them in half
+// around a power of ten and recursing; smaller ones use the direct loops.
+static constexpr size_t DecimalSplitDigits = 576;
+static constexpr uint32_t DecimalSplitWords = 32;
+
+// Builds a table of 10^(9 * 2^i), stopping once an entry would be larger than
+// half of a number with the given count of decimal digits.
+static void buildDecimalPowers(SmallVectorBase<SVInt>& powers, size_t numDigits) {
+    SVInt power(32, DecimalChunkDivisor, false);
+    while ((size_t(DecimalChunkDigits) << powers.size()) * 2 <= numDigits) {
+        powers.push_back(power);
+
+        power = power.resize(power.getActiveBits() * 2);
+        power *= power;
+    }
+}
+
 const logic_t logic_t::x{logic_t::X_VALUE};
 const logic_t logic_t::z{logic_t::Z_VALUE};
 
@@ -255,6 +278,19 @@ SVInt SVInt::fromDigits(bitwidth_t bits, LiteralBase base, bool isSigned, bool a
 }
 
 SVInt SVInt::fromDecimalDigits(bitwidth_t bits, bool isSigned, std::span<logic_t const> digits) {
+    if (digits.size() > DecimalSplitDigits) {
+        // Long digit strings get split up recursively so that the bulk of
+        // the work happens in a few large (Karatsuba) multiplies instead of
+        // a full width multiply-add for every chunk of digits.
+        SmallVector<SVInt> powers;
+        buildDecimalPowers(powers, digits.size());
+
+        SVInt result = fromDecimalDigitsSplit(digits, powers);
+        result = result.resize(bits);
+        result.setSigned(isSigned);
+        return result;
+    }
+
     SVInt result = allocZeroed(bits, isSigned, false);
 
     constexpr int charsPerWord = 18; // 18 decimal digits can fit in a 64-bit word
@@ -308,6 +344,32 @@ SVInt SVInt::fromDecimalDigits(bitwidth_t bits, bool isSigned, std::span<logic_t
     return result;
 }
 
+SVInt SVInt::fromDecimalDigitsSplit(std::span<logic_t const> digits,
+                                    std::span<const SVInt> powers) {
+    // Results are computed at the width needed to hold all of the digits, saturated
+    // at the max width. Anything above that gets truncated, which is fine since
+    // all of the arithmetic here is modulo 2^width anyway.
+    double neededBits = ceil(double(digits.size()) * log2_10) + 1;
+    bitwidth_t width = bitwidth_t(std::min(neededBits, double(MAX_BITS)));
+    if (digits.size() <= DecimalSplitDigits)
+        return fromDecimalDigits(width, false, digits);
+
+    // Find the largest power that leaves at least as many digits in the upper half.
+    size_t index = powers.size() - 1;
+    while ((size_t(DecimalChunkDigits) << index) * 2 > digits.size())
+        index--;
+
+    size_t lowDigits = size_t(DecimalChunkDigits) << index;
+    auto splitPoint = digits.size() - lowDigits;
+    SVInt high = fromDecimalDigitsSplit(digits.first(splitPoint), powers);
+    SVInt low = fromDecimalDigitsSplit(digits.subspan(splitPoint), powers);
+
+    SVInt result = high.resize(width);
+    result *= powers[index].resize(width);
+    result += low.resize(width);
+    return result;
+}
+
 SVInt SVInt::fromPow2Digits(bitwidth_t bits, bool isSigned, bool anyUnknown, uint32_t radix,
                             uint32_t shift, std::span<logic_t const> digits) {
 
@@ -777,22 +839,16 @@ void SVInt::writeTo(SmallVectorBase<char>& buffer, LiteralBase base, bool includ
                 tmp = quotient;
             }
 
-            // repeatedly divide by 10 to get each digit
-            SVInt divisor(4, 10, false);
-            while (tmp != 0) {
-                SVInt remainder;
-                SVInt quotient;
-                divide(tmp, tmp.getNumWords(), divisor, divisor.getNumWords(), &quotient,
-                       &remainder);
-                uint64_t digit = remainder.as<uint64_t>().value();
-                SLANG_ASSERT(digit < 10);
-                buffer.push_back(Digits[digit]);
-                tmp = quotient;
-            }
+            SmallVector<SVInt> powers;
+            bitwidth_t valueBits = tmp.getActiveBits();
+            if (valueBits > DecimalSplitWords * BITS_PER_WORD)
+                buildDecimalPowers(powers, size_t(valueBits / log2_10) + 1);
+
+            tmp.writeDecimalDigits(buffer, 0, powers);
         }
     }
     else {
-        // for bases 2, 8, and 16 we can just shift instead of dividing
+        // for bases 2, 8, and 16 we can just pick out the bits for each digit
         uint32_t shiftAmount = 0;
         uint32_t maskAmount = 0;
         switch (base) {
@@ -812,19 +868,41 @@ void SVInt::writeTo(SmallVectorBase<char>& buffer, LiteralBase base, bool includ
                 SLANG_UNREACHABLE;
         }
 
-        // if we have unknown values here, the comparison will return X
-        // we want to keep going so that we print the unknowns
+        // Figure out how many digits we need by finding the topmost bit that is
+        // set in either the value or the unknown planes; everything above that
+        // is a leading zero that doesn't get printed.
+        uint32_t words = getNumWords(bitWidth, false);
+        const uint64_t* data = tmp.getRawData();
+        const uint64_t* unknownData = tmp.unknownFlag ? data + words : nullptr;
+
+        bitwidth_t topBit = 0;
+        for (uint32_t i = words; i > 0; i--) {
+            uint64_t word = data[i - 1] | (unknownData ? unknownData[i - 1] : 0);
+            if (word) {
+                topBit = (i - 1) * BITS_PER_WORD + bitwidth_t(std::bit_width(word));
+                break;
+            }
+        }
+
+        auto getDigitBits = [&](const uint64_t* src, bitwidth_t bit) {
+            uint32_t word = whichWord(bit);
+            uint32_t offset = whichBit(bit);
+            uint64_t result = src[word] >> offset;
+            if (offset + shiftAmount > BITS_PER_WORD && word + 1 < words)
+                result |= src[word + 1] << (BITS_PER_WORD - offset);
+            return uint32_t(result) & maskAmount;
+        };
+
         int bitsLeft = int(tmp.getBitWidth());
-        logic_t x = tmp != 0;
-        while (x || x.isUnknown()) {
+        for (bitwidth_t bit = 0; bit < topBit; bit += shiftAmount) {
             if (bitsLeft < int(shiftAmount))
                 maskAmount = (1 << bitsLeft) - 1;
 
-            uint32_t digit = uint32_t(tmp.getRawData()[0]) & maskAmount;
-            if (!tmp.unknownFlag)
+            uint32_t digit = getDigitBits(data, bit);
+            if (!unknownData)
                 buffer.push_back(Digits[digit]);
             else {
-                uint32_t u = uint32_t(tmp.pVal[getNumWords(bitWidth, false)]) & maskAmount;
+                uint32_t u = getDigitBits(unknownData, bit);
                 if (!u)
                     buffer.push_back(Digits[digit]);
                 else if (u == maskAmount && (digit & maskAmount) == 0)
@@ -836,11 +914,7 @@ void SVInt::writeTo(SmallVectorBase<char>& buffer, LiteralBase base, bool includ
                 else
                     buffer.push_back('Z');
             }
-            // this shift might shift away the unknown digits, at which point
-            // it converts back to being a normal 2-state value
-            tmp = tmp.lshr(shiftAmount);
             bitsLeft -= int(shiftAmount);
-            x = tmp != 0;
         }
 
         // If there are bits left over and the last digit we pushed was
@@ -863,6 +937,62 @@ void SVInt::writeTo(SmallVectorBase<char>& buffer, LiteralBase base, bool includ
     }
 }
 
+void SVInt::writeDecimalDigits(SmallVectorBase<char>& buffer, size_t minDigits,
+                               std::span<const SVInt> powers) const {
+    SLANG_ASSERT(!unknownFlag);
+
+    bitwidth_t activeBits = getActiveBits();
+    uint32_t activeWords = !activeBits ? 0 : whichWord(activeBits - 1) + 1;
+    size_t startOffset = buffer.size();
+
+    if (activeWords <= DecimalSplitWords || powers.empty()) {
+        // Repeatedly divide out chunks of digits from a scratch copy of the words.
+        TempBuffer<uint64_t, DecimalSplitWords> scratch(activeWords);
+        uint64_t* words = scratch.get();
+        if (activeWords)
+            memcpy(words, getRawData(), activeWords * WORD_SIZE);
+
+        while (activeWords) {
+            uint32_t chunk = divOne(words, activeWords, DecimalChunkDivisor);
+            while (activeWords && words[activeWords - 1] == 0)
+                activeWords--;
+
+            // The final chunk doesn't need to be padded out with zeros.
+            if (!activeWords) {
+                for (; chunk; chunk /= 10)
+                    buffer.push_back(char('0' + chunk % 10));
+            }
+            else {
+                for (uint32_t i = 0; i < DecimalChunkDigits; i++, chunk /= 10)
+                    buffer.push_back(char('0' + chunk % 10));
+            }
+        }
+    }
+    else {
+        // Split around the largest power of ten that is no more than half our size,
+        // then write out the low half (fully padded) followed by the high half.
+        size_t index = powers.size() - 1;
+        while (powers[index].getActiveBits() * 2 > activeBits)
+            index--;
+
+        const SVInt& divisor = powers[index];
+        bitwidth_t divisorBits = divisor.getActiveBits();
+        uint32_t divisorWords = whichWord(divisorBits - 1) + 1;
+
+        SVInt quotient;
+        SVInt remainder;
+        divide(*this, activeWords, divisor, divisorWords, &quotient, &remainder);
+
+        size_t lowDigits = size_t(DecimalChunkDigits) << index;
+        remainder.writeDecimalDigits(buffer, lowDigits, powers);
+        quotient.writeDecimalDigits(buffer, minDigits > lowDigits ? minDigits - lowDigits : 0,
+                                    powers);
+    }
+
+    while (buffer.size() - startOffset < minDigits)
+        buffer.push_back('0');
+}
+
 SVInt SVInt::pow(const SVInt& rhs) const {
     // ignore unknowns
     if (unknownFlag || rhs.unknownFlag)
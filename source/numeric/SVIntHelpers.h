@@ -226,6 +226,26 @@ static bool addOne(uint64_t* dst, uint64_t* src, uint32_t len, uint64_t value) {
     return carry;
 }
 
+// Specialized in-place divider for 32-bit divisors; returns the remainder.
+// Each 64-bit word is processed as two halves so that every partial dividend
+// fits natively in 64 bits.
+static uint32_t divOne(uint64_t* words, uint32_t len, uint32_t divisor) {
+    uint64_t rem = 0;
+    for (uint32_t i = len; i > 0; i--) {
+        uint64_t word = words[i - 1];
+        uint64_t hi = (rem << 32) | (word >> 32);
+        uint64_t qhi = hi / divisor;
+        rem = hi % divisor;
+
+        uint64_t lo = (rem << 32) | (word & UINT32_MAX);
+        uint64_t qlo = lo / divisor;
+        rem = lo % divisor;
+
+        words[i - 1] = (qhi << 32) | qlo;
+    }
+    return uint32_t(rem);
+}
+
 // Specialized subtractor for values <= 64.
 static bool subOne(uint64_t* dst, uint64_t* src, uint32_t len, uint64_t value) {
     uint8_t borrow = 0;
@@ -296,7 +316,9 @@ static void mulKaratsuba(uint64_t* dst, const uint64_t* x, uint32_t xlen, const
 // Generalized multiplier
 SLANG_NO_SANITIZE("unsigned-integer-overflow")
 static void mul(uint64_t* dst, const uint64_t* x, uint32_t xlen, const uint64_t* y, uint32_t ylen) {
-    if (xlen > 7 && ylen > 7) {
+    // Karatsuba splits both operands at half the length of the longer one,
+    // so it's only usable when the lengths are reasonably balanced.
+    if (xlen > 7 && ylen > 7 && xlen >= ylen / 2 && ylen >= xlen / 2) {
         mulKaratsuba(dst, x, xlen, y, ylen);
         return;
     }
@@ -39,6 +39,13 @@ Lexer::Lexer(SourceBuffer buffer, BumpAllocator& alloc, Diagnostics& diagnostics
     library = buffer.library;
 }
 
+Lexer::Lexer(SourceBuffer buffer, size_t startOffset, BumpAllocator& alloc,
+             Diagnostics& diagnostics, LexerOptions options) :
+    Lexer(buffer.id, buffer.data, buffer.data.data() + startOffset, alloc, diagnostics, options) {
+    SLANG_ASSERT(startOffset < buffer.data.size());
+    library = buffer.library;
+}
+
 Lexer::Lexer(BufferID bufferId, std::string_view source, const char* startPtr, BumpAllocator& alloc,
              Diagnostics& diagnostics, LexerOptions options) :
     alloc(alloc), diagnostics(diagnostics), options(options), bufferId(bufferId),
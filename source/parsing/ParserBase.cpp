@@ -117,6 +117,17 @@ Token ParserBase::expect(TokenKind kind) {
     return result;
 }
 
+void ParserBase::skipTokens(uint32_t count) {
+    // Unlike skipToken, this skips exactly the requested number of tokens
+    // without issuing any diagnostics or trying to match up delimiters.
+    for (uint32_t i = 0; i < count; i++) {
+        auto token = peek();
+        SLANG_ASSERT(token.kind != TokenKind::EndOfFile);
+        skippedTokens.push_back(token);
+        window.moveToNext();
+    }
+}
+
 void ParserBase::skipToken(std::optional<DiagCode> diagCode) {
     auto token = peek();
     SLANG_ASSERT(token.kind != TokenKind::EndOfFile);
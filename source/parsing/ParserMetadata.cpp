@@ -15,7 +15,7 @@ using namespace syntax;
 
 namespace {
 
-class MetadataVisitor : public SyntaxVisitor<MetadataVisitor> {
+class MetadataVisitor : public SyntaxVisitor<MetadataVisitor, true> {
 public:
     ParserMetadata meta;
 
@@ -6,8 +6,10 @@
 // SPDX-License-Identifier: MIT
 //------------------------------------------------------------------------------
 #include "slang/diagnostics/ParserDiags.h"
+#include "slang/parsing/LexerFacts.h"
 #include "slang/parsing/Parser.h"
 #include "slang/parsing/Preprocessor.h"
+#include "slang/text/SourceManager.h"
 #include "slang/util/String.h"
 
 namespace slang::parsing {
@@ -78,11 +80,28 @@ MemberSyntax& Parser::parseModule(AttrList attributes, SyntaxKind parentKind,
     auto savedDefinitionKind = currentDefinitionKind;
     currentDefinitionKind = declKind;
 
+    // If requested, skip over the body of the definition so that it can be
+    // parsed later on demand, only if and when it's actually needed.
+    uint32_t bodyTokens = 0;
+    if (parseOptions.deferModuleBodies && parentKind == SyntaxKind::CompilationUnit &&
+        declKind != SyntaxKind::PackageDeclaration) {
+        bodyTokens = scanDeferrableBody(endKind, attributes, header);
+    }
+
     Token endmodule;
-    auto members = parseMemberList<MemberSyntax>(
-        endKind, endmodule, declKind, [this](SyntaxKind parentKind, bool& anyLocalModules) {
-            return parseMember(parentKind, anyLocalModules);
-        });
+    std::span<MemberSyntax*> members;
+    if (bodyTokens) {
+        // The skipped tokens get attached to the end keyword as trivia
+        // so that the tree still faithfully represents the source text.
+        skipTokens(bodyTokens - 1);
+        endmodule = consume();
+    }
+    else {
+        members = parseMemberList<MemberSyntax>(
+            endKind, endmodule, declKind, [this](SyntaxKind parentKind, bool& anyLocalModules) {
+                return parseMember(parentKind, anyLocalModules);
+            });
+    }
 
     currentDefinitionKind = savedDefinitionKind;
     pp.popDesignElementStack();
@@ -94,9 +113,123 @@ MemberSyntax& Parser::parseModule(AttrList attributes, SyntaxKind parentKind,
                                              endName);
 
     meta.nodeMap[&result] = node;
+    if (bodyTokens)
+        meta.deferredBodies.emplace(&result);
+
     return result;
 }
 
+static bool isPlainToken(Token token, BufferID buffer, bool checkTrivia) {
+    if (token.isMissing() || token.location().buffer() != buffer)
+        return false;
+
+    if (checkTrivia) {
+        for (auto& trivia : token.trivia()) {
+            switch (trivia.kind) {
+                case TriviaKind::Whitespace:
+                case TriviaKind::EndOfLine:
+                case TriviaKind::LineComment:
+                case TriviaKind::BlockComment:
+                    break;
+                default:
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool isPlainNode(const SyntaxNode& node, BufferID buffer, bool& first) {
+    for (size_t i = 0; i < node.getChildCount(); i++) {
+        if (auto child = node.childNode(i)) {
+            if (!isPlainNode(*child, buffer, first))
+                return false;
+        }
+        else if (auto token = node.childToken(i)) {
+            // The leading trivia of the first token is allowed to contain
+            // directives since the body is reparsed starting after it.
+            if (!isPlainToken(token, buffer, !first))
+                return false;
+            first = false;
+        }
+    }
+    return true;
+}
+
+uint32_t Parser::scanDeferrableBody(TokenKind endKind, AttrList attributes,
+                                    const ModuleHeaderSyntax& header) {
+    // Bodies are reparsed later directly from the source text, without any
+    // of the preprocessor state that is active here. That means we can only
+    // defer a definition if the preprocessor had no hand in producing any of
+    // its tokens and the keyword set in effect is the default one.
+    auto& pp = getPP();
+    auto buffer = header.moduleKeyword.location().buffer();
+    if (!pp.getSourceManager().isFileLoc(header.moduleKeyword.location()) ||
+        pp.getCurrentKeywordVersion() !=
+            LexerFacts::getDefaultKeywordVersion(parseOptions.languageVersion)) {
+        return 0;
+    }
+
+    bool first = true;
+    for (auto attr : attributes) {
+        if (!isPlainNode(*attr, buffer, first))
+            return 0;
+    }
+
+    if (!isPlainNode(header, buffer, first))
+        return 0;
+
+    // Scan ahead for the end keyword. Anything that contributes to the parser
+    // metadata in ways that can't be reconstructed cheaply, or that could
+    // contain a nested definition, causes us to give up and parse normally.
+    auto& diagnostics = getDiagnostics();
+    const size_t numDiags = diagnostics.size();
+    SmallVector<std::string_view> instanceNames;
+
+    for (uint32_t index = 0;; index++) {
+        auto token = peek(index);
+        if (!isPlainToken(token, buffer, true) || diagnostics.size() != numDiags)
+            return 0;
+
+        switch (token.kind) {
+            case TokenKind::EndOfFile:
+            case TokenKind::ModuleKeyword:
+            case TokenKind::MacromoduleKeyword:
+            case TokenKind::InterfaceKeyword:
+            case TokenKind::ProgramKeyword:
+            case TokenKind::PackageKeyword:
+            case TokenKind::ClassKeyword:
+            case TokenKind::ImportKeyword:
+            case TokenKind::DoubleColon:
+            case TokenKind::DefParamKeyword:
+            case TokenKind::BindKeyword:
+                return 0;
+            case TokenKind::Identifier: {
+                // Conservatively record anything that looks like the start of
+                // a hierarchy instantiation so that top-level module selection
+                // and library file lookup still see the names it references.
+                // Instance arrays put their dimensions between the instance
+                // name and the port connections.
+                auto next = peek(index + 1).kind;
+                if (next == TokenKind::Hash ||
+                    (next == TokenKind::Identifier &&
+                     (peek(index + 2).kind == TokenKind::OpenParenthesis ||
+                      peek(index + 2).kind == TokenKind::OpenBracket))) {
+                    instanceNames.push_back(token.valueText());
+                }
+                break;
+            }
+            default:
+                if (token.kind == endKind) {
+                    for (auto name : instanceNames)
+                        meta.globalInstances.emplace(name);
+                    return index + 1;
+                }
+                break;
+        }
+    }
+}
+
 AnonymousProgramSyntax& Parser::parseAnonymousProgram(AttrList attributes) {
     auto& pp = getPP();
     pp.pushDesignElementStack();
@@ -421,6 +554,10 @@ MemberSyntax* Parser::parseSingleMember(SyntaxKind parentKind) {
     return result;
 }
 
+MemberSyntax* Parser::parseSingleClassMember(bool isIfaceClass, bool hasBaseClass) {
+    return parseClassMember(isIfaceClass, hasBaseClass);
+}
+
 template<typename TMember, typename TParseFunc>
 std::span<TMember*> Parser::parseMemberList(TokenKind endKind, Token& endToken,
                                             SyntaxKind parentKind, TParseFunc&& parseFunc) {
@@ -101,6 +101,13 @@ void Preprocessor::pushSource(SourceBuffer buffer) {
     lexerStack.emplace_back(std::make_unique<Lexer>(buffer, alloc, diagnostics, lexerOptions));
 }
 
+void Preprocessor::pushSource(SourceBuffer buffer, size_t startOffset) {
+    SLANG_ASSERT(buffer.id);
+
+    lexerStack.emplace_back(
+        std::make_unique<Lexer>(buffer, startOffset, alloc, diagnostics, lexerOptions));
+}
+
 void Preprocessor::popSource() {
     if (includeDepth)
         includeDepth--;
@@ -125,12 +132,14 @@ void Preprocessor::predefine(const std::string& definition, std::string_view nam
             macros.insert(pair);
         }
     }
+    clearExpansionCache();
 }
 
 bool Preprocessor::undefine(std::string_view name) {
     auto it = macros.find(name);
     if (it != macros.end() && !it->second.isIntrinsic()) {
         macros.erase(it);
+        clearExpansionCache();
         return true;
     }
     return false;
@@ -138,6 +147,7 @@ bool Preprocessor::undefine(std::string_view name) {
 
 void Preprocessor::undefineAll() {
     macros.clear();
+    clearExpansionCache();
     macros["__FILE__"] = MacroIntrinsic::File;
     macros["__LINE__"] = MacroIntrinsic::Line;
 
@@ -674,8 +684,10 @@ Trivia Preprocessor::handleDefineDirective(Token directive) {
         }
     }
 
-    if (!bad)
+    if (!bad) {
         macros[name.valueText()] = result;
+        clearExpansionCache();
+    }
     return Trivia(TriviaKind::Directive, result);
 }
 
@@ -951,8 +963,10 @@ Trivia Preprocessor::handleUndefDirective(Token directive) {
         std::string_view name = nameToken.valueText();
         auto it = macros.find(name);
         if (it != macros.end()) {
-            if (!it->second.builtIn)
+            if (!it->second.builtIn) {
                 macros.erase(it);
+                clearExpansionCache();
+            }
             else
                 addDiag(diag::UndefineBuiltinDirective, nameToken.range());
         }
@@ -975,8 +989,11 @@ Trivia Preprocessor::handleBeginKeywordsDirective(Token directive) {
         auto versionOpt = LF::getKeywordVersion(versionToken.valueText());
         if (!versionOpt)
             addDiag(diag::UnrecognizedKeywordVersion, versionToken.range());
-        else
+        else {
+            // Token splitting during expansion depends on the keyword version.
             keywordVersionStack.push_back(*versionOpt);
+            clearExpansionCache();
+        }
     }
 
     auto result = alloc.emplace<BeginKeywordsDirectiveSyntax>(directive, versionToken);
@@ -988,8 +1005,10 @@ Trivia Preprocessor::handleEndKeywordsDirective(Token directive) {
 
     if (keywordVersionStack.size() == 1)
         addDiag(diag::MismatchedEndKeywordsDirective, directive.range());
-    else
+    else {
         keywordVersionStack.pop_back();
+        clearExpansionCache();
+    }
 
     return createSimpleDirective(directive);
 }
@@ -91,6 +91,35 @@ std::pair<MacroActualArgumentListSyntax*, Trivia> Preprocessor::handleTopLevelMa
             return {nullptr, Trivia()};
     }
 
+    // See if we've already expanded this exact usage before. We can only do that
+    // when the whole usage comes from a single file buffer, since we need to map
+    // locations in the cached tokens over to the new usage site.
+    std::string cacheKey;
+    std::optional<SourceRange> usageRange;
+    if (!macro.isIntrinsic()) {
+        SourceLocation usageEnd = directive.location() + directive.rawText().length();
+        if (actualArgs) {
+            Token last = actualArgs->getLastToken();
+            usageEnd = last.location() + last.rawText().length();
+        }
+
+        if (usageEnd.buffer() == directive.location().buffer()) {
+            usageRange = SourceRange(directive.location(), usageEnd);
+            cacheKey = directive.rawText();
+            if (actualArgs)
+                cacheKey += actualArgs->toString();
+
+            if (auto it = expansionCache.find(cacheKey); it != expansionCache.end()) {
+                reuseExpansion(it->second, *usageRange);
+                numReusedExpansions++;
+                return {actualArgs, Trivia()};
+            }
+        }
+    }
+
+    const size_t numDiags = diagnostics.size();
+    expandedIntrinsic = false;
+
     // Expand out the macro
     SmallVector<Token, 32> buffer;
     MacroExpansion expansion{sourceManager, alloc, buffer, directive, true};
@@ -124,6 +153,15 @@ std::pair<MacroActualArgumentListSyntax*, Trivia> Preprocessor::handleTopLevelMa
         tokens = expandedTokens;
     }
 
+    // Results that depend on the usage location or that produced
+    // errors can't be reused for other usages. Most usages only ever appear
+    // once, so we only pay for copying the tokens into the cache once the
+    // same usage shows up a second time.
+    if (usageRange && !expandedIntrinsic && diagnostics.size() == numDiags &&
+        !seenExpansions.emplace(cacheKey).second) {
+        cacheExpansion(std::move(cacheKey), *usageRange);
+    }
+
     // if the macro expanded into any tokens at all, set the pointer
     // so that we'll pull from them next
     if (!expandedTokens.empty())
@@ -132,6 +170,84 @@ std::pair<MacroActualArgumentListSyntax*, Trivia> Preprocessor::handleTopLevelMa
     return {actualArgs, Trivia()};
 }
 
+void Preprocessor::cacheExpansion(std::string&& key, SourceRange usageRange) {
+    // Collect every expansion location referenced by the expanded tokens,
+    // making sure that any location an entry depends on comes before it.
+    SmallVector<CachedExpansion::ExpansionLoc> expansionLocs;
+    flat_hash_set<BufferID> seen;
+
+    auto addLoc = [&](auto& self, SourceLocation loc) -> void {
+        if (!sourceManager.isMacroLoc(loc) || !seen.insert(loc.buffer()).second)
+            return;
+
+        SourceLocation base(loc.buffer(), 0);
+        CachedExpansion::ExpansionLoc entry;
+        entry.buffer = loc.buffer();
+        entry.originalLoc = sourceManager.getOriginalLoc(base);
+        entry.expansionRange = sourceManager.getExpansionRange(base);
+        entry.isMacroArg = sourceManager.isMacroArgLoc(base);
+        if (!entry.isMacroArg)
+            entry.macroName = sourceManager.getMacroName(base);
+
+        self(self, entry.originalLoc);
+        self(self, entry.expansionRange.start());
+        self(self, entry.expansionRange.end());
+        expansionLocs.push_back(entry);
+    };
+
+    for (auto& token : expandedTokens)
+        addLoc(addLoc, token.location());
+
+    CachedExpansion cached;
+    cached.tokens = expandedTokens.copy(alloc);
+    cached.expansionLocs = expansionLocs.copy(alloc);
+    cached.usageRange = usageRange;
+    expansionCache.emplace(std::move(key), cached);
+}
+
+void Preprocessor::clearExpansionCache() {
+    expansionCache.clear();
+    seenExpansions.clear();
+}
+
+void Preprocessor::reuseExpansion(const CachedExpansion& cached, SourceRange usageRange) {
+    // The usage text is identical, so locations within the old usage map to
+    // the same offset within the new one. Expansion locations get recreated
+    // in order so that each one can point at the new versions of its parents.
+    flat_hash_map<BufferID, BufferID> bufferMap;
+    auto remap = [&](SourceLocation loc) {
+        if (auto it = bufferMap.find(loc.buffer()); it != bufferMap.end())
+            return SourceLocation(it->second, loc.offset());
+
+        auto oldRange = cached.usageRange;
+        if (loc.buffer() == oldRange.start().buffer() && loc >= oldRange.start() &&
+            loc <= oldRange.end()) {
+            return usageRange.start() + (loc - oldRange.start());
+        }
+        return loc;
+    };
+
+    for (auto& entry : cached.expansionLocs) {
+        SourceLocation originalLoc = remap(entry.originalLoc);
+        SourceRange expansionRange(remap(entry.expansionRange.start()),
+                                   remap(entry.expansionRange.end()));
+
+        SourceLocation loc;
+        if (entry.isMacroArg)
+            loc = sourceManager.createExpansionLoc(originalLoc, expansionRange, true);
+        else
+            loc = sourceManager.createExpansionLoc(originalLoc, expansionRange, entry.macroName);
+        bufferMap.emplace(entry.buffer, loc.buffer());
+    }
+
+    expandedTokens.clear();
+    for (auto& token : cached.tokens)
+        expandedTokens.push_back(token.withLocation(alloc, remap(token.location())));
+
+    if (!expandedTokens.empty())
+        currentMacroToken = expandedTokens.begin();
+}
+
 bool Preprocessor::applyMacroOps(std::span<Token const> tokens, SmallVectorBase<Token>& dest) {
     SmallVector<Trivia, 8> emptyArgTrivia;
     SmallVector<Token, 8> stringifyBuffer;
@@ -703,6 +819,7 @@ bool Preprocessor::expandReplacementList(
 }
 
 bool Preprocessor::expandIntrinsic(MacroIntrinsic intrinsic, MacroExpansion& expansion) {
+    expandedIntrinsic = true;
     auto loc = expansion.getRange().start();
     SmallVector<char> text;
     switch (intrinsic) {
@@ -19,23 +19,18 @@ namespace slang::parsing {
 using namespace syntax;
 
 // Heap-allocated info block. This structure is variably sized based on the
-// actual type of token. Type-specific data is stored at the end, followed
-// by any trivia if the token has it.
+// actual type of token. A pointer to the raw text follows the location if the
+// token's text isn't implied by its kind, then any type-specific data, then
+// any trivia if the token has it.
 struct Token::Info {
-    // Pointer to the raw text for the token; the size is stored in the token itself.
-    const char* rawTextPtr;
-
     // The original location in the source text (or a macro location
     // if the token was generated during macro expansion).
     SourceLocation location;
 
     byte* extra() { return reinterpret_cast<byte*>(this + 1); }
 
-    logic_t& bit() { return *reinterpret_cast<logic_t*>(extra()); }
-    double& real() { return *reinterpret_cast<double*>(extra()); }
-    SVIntStorage& integer() { return *reinterpret_cast<SVIntStorage*>(extra()); }
-    std::string_view& stringText() { return *reinterpret_cast<std::string_view*>(extra()); }
-    SyntaxKind& directiveKind() { return *reinterpret_cast<SyntaxKind*>(extra()); }
+    // Only valid if the token stores its own raw text; the size is stored in the token itself.
+    const char*& rawTextPtr() { return *reinterpret_cast<const char**>(extra()); }
 };
 
 static constexpr size_t getExtraSize(TokenKind kind) {
@@ -198,21 +193,21 @@ Token::Token(BumpAllocator& alloc, TokenKind kind, std::span<Trivia const> trivi
              std::string_view rawText, SourceLocation location, std::string_view strText) {
     SLANG_ASSERT(kind == TokenKind::StringLiteral || kind == TokenKind::IncludeFileName);
     init(alloc, kind, trivia, rawText, location);
-    info->stringText() = strText;
+    extraAs<std::string_view>() = strText;
 }
 
 Token::Token(BumpAllocator& alloc, TokenKind kind, std::span<Trivia const> trivia,
              std::string_view rawText, SourceLocation location, SyntaxKind directive) {
     SLANG_ASSERT(kind == TokenKind::Directive || kind == TokenKind::MacroUsage);
     init(alloc, kind, trivia, rawText, location);
-    info->directiveKind() = directive;
+    extraAs<SyntaxKind>() = directive;
 }
 
 Token::Token(BumpAllocator& alloc, TokenKind kind, std::span<Trivia const> trivia,
              std::string_view rawText, SourceLocation location, logic_t bit) {
     SLANG_ASSERT(kind == TokenKind::UnbasedUnsizedLiteral);
     init(alloc, kind, trivia, rawText, location);
-    info->bit() = bit;
+    extraAs<logic_t>() = bit;
 }
 
 Token::Token(BumpAllocator& alloc, TokenKind kind, std::span<Trivia const> trivia,
@@ -229,7 +224,7 @@ Token::Token(BumpAllocator& alloc, TokenKind kind, std::span<Trivia const> trivi
         memcpy(storage.pVal, value.getRawPtr(), sizeof(uint64_t) * value.getNumWords());
     }
 
-    info->integer() = storage;
+    extraAs<SVIntStorage>() = storage;
 }
 
 Token::Token(BumpAllocator& alloc, TokenKind kind, std::span<Trivia const> trivia,
@@ -237,7 +232,7 @@ Token::Token(BumpAllocator& alloc, TokenKind kind, std::span<Trivia const> trivi
              std::optional<TimeUnit> timeUnit) {
     SLANG_ASSERT(kind == TokenKind::RealLiteral || kind == TokenKind::TimeLiteral);
     init(alloc, kind, trivia, rawText, location);
-    info->real() = value;
+    extraAs<double>() = value;
 
     numFlags.setOutOfRange(outOfRange);
     if (timeUnit)
@@ -253,7 +248,7 @@ Token::Token(BumpAllocator& alloc, TokenKind kind, std::span<Trivia const> trivi
 std::string_view Token::valueText() const {
     switch (kind) {
         case TokenKind::StringLiteral:
-            return info->stringText();
+            return extraAs<std::string_view>();
         case TokenKind::Identifier: {
             std::string_view result = rawText();
             if (!result.empty() && result[0] == '\\')
@@ -285,11 +280,10 @@ std::string_view Token::rawText() const {
         case TokenKind::MacroUsage:
         case TokenKind::EmptyMacroArgument:
         case TokenKind::LineContinuation:
-            return std::string_view(info->rawTextPtr, rawLen);
         case TokenKind::Unknown:
-            if (info)
-                return std::string_view(info->rawTextPtr, rawLen);
-            return "";
+            if (!rawLen)
+                return "";
+            return std::string_view(info->rawTextPtr(), rawLen);
         case TokenKind::Placeholder:
         case TokenKind::EndOfFile:
             return "";
@@ -313,7 +307,7 @@ std::span<Trivia const> Token::trivia() const {
         return {};
 
     const Trivia* trivia;
-    byte* ptr = info->extra() + getExtraSize(kind);
+    byte* ptr = extra() + getExtraSize(kind);
     memcpy(reinterpret_cast<void*>(&trivia), ptr, sizeof(trivia));
 
     if (triviaCountSmall == MaxTriviaSmallCount + 1) {
@@ -331,17 +325,17 @@ std::string Token::toString() const {
 
 SVInt Token::intValue() const {
     SLANG_ASSERT(kind == TokenKind::IntegerLiteral);
-    return info->integer();
+    return extraAs<SVIntStorage>();
 }
 
 double Token::realValue() const {
     SLANG_ASSERT(kind == TokenKind::RealLiteral || kind == TokenKind::TimeLiteral);
-    return info->real();
+    return extraAs<double>();
 }
 
 logic_t Token::bitValue() const {
     SLANG_ASSERT(kind == TokenKind::UnbasedUnsizedLiteral);
-    return info->bit();
+    return extraAs<logic_t>();
 }
 
 NumericTokenFlags Token::numericFlags() const {
@@ -352,7 +346,7 @@ NumericTokenFlags Token::numericFlags() const {
 
 SyntaxKind Token::directiveKind() const {
     SLANG_ASSERT(kind == TokenKind::Directive || kind == TokenKind::MacroUsage);
-    return info->directiveKind();
+    return extraAs<SyntaxKind>();
 }
 
 bool Token::isOnSameLine() const {
@@ -398,7 +392,7 @@ Token Token::clone(BumpAllocator& alloc, std::span<Trivia const> trivia, std::st
     Token result(alloc, kind, trivia, rawText, location);
     result.missing = missing;
 
-    memcpy(result.info->extra(), info->extra(), getExtraSize(kind));
+    memcpy(result.extra(), extra(), getExtraSize(kind));
     memcpy(&result.numFlags, &numFlags, 1);
 
     return result;
@@ -424,12 +418,20 @@ void Token::init(BumpAllocator& alloc, TokenKind kind_, std::span<Trivia const>
     triviaCountSmall = 0;
     reserved = 0;
     numFlags.raw = 0;
-    rawLen = uint32_t(rawText.size());
+
+    // Tokens whose text is implied by their kind (keywords, punctuation) don't
+    // store a pointer to it, which is the majority of tokens in most sources.
+    // A zero raw length signals that no text pointer is present.
+    rawLen = LexerFacts::getTokenKindText(kind).empty() ? uint32_t(rawText.size()) : 0;
 
     size_t extra = getExtraSize(kind);
     SLANG_ASSERT(extra % alignof(void*) == 0);
+    static_assert(sizeof(Info) % alignof(void*) == 0);
 
     size_t size = sizeof(Info) + extra;
+    if (rawLen)
+        size += sizeof(const char*);
+
     if (!trivia.empty()) {
         size += sizeof(Trivia*);
         if (trivia.size() > MaxTriviaSmallCount) {
@@ -441,13 +443,14 @@ void Token::init(BumpAllocator& alloc, TokenKind kind_, std::span<Trivia const>
         }
     }
 
-    info = (Info*)alloc.allocate(size, alignof(Info));
+    info = (Info*)alloc.allocate(size, alignof(void*));
     info->location = location;
-    info->rawTextPtr = rawText.data();
+    if (rawLen)
+        info->rawTextPtr() = rawText.data();
 
     if (!trivia.empty()) {
         const Trivia* triviaPtr = trivia.data();
-        byte* dest = info->extra() + extra;
+        byte* dest = this->extra() + extra;
         memcpy(dest, reinterpret_cast<const void*>(&triviaPtr), sizeof(triviaPtr));
 
         if (trivia.size() > MaxTriviaSmallCount) {
@@ -457,6 +460,13 @@ void Token::init(BumpAllocator& alloc, TokenKind kind_, std::span<Trivia const>
     }
 }
 
+byte* Token::extra() const {
+    byte* ptr = info->extra();
+    if (rawLen)
+        ptr += sizeof(const char*);
+    return ptr;
+}
+
 Token Token::createMissing(BumpAllocator& alloc, TokenKind kind, SourceLocation location) {
     Token result;
     switch (kind) {
@@ -42,7 +42,7 @@ SyntaxPrinter& SyntaxPrinter::print(Trivia trivia) {
             break;
         case TriviaKind::DisabledText:
             if (includeSkipped)
-                append(trivia.getRawText());
+                appendText(trivia.getRawText(), true);
             break;
         case TriviaKind::LineComment:
         case TriviaKind::BlockComment:
@@ -50,7 +50,7 @@ SyntaxPrinter& SyntaxPrinter::print(Trivia trivia) {
                 break;
             [[fallthrough]];
         default:
-            append(trivia.getRawText());
+            appendText(trivia.getRawText(), true);
             break;
     }
     return *this;
@@ -90,8 +90,12 @@ SyntaxPrinter& SyntaxPrinter::print(Token token) {
         }
     }
 
-    if (!excluded && (includeMissing || !token.isMissing()))
-        append(token.rawText());
+    if (!excluded && (includeMissing || !token.isMissing())) {
+        if (sliceMode)
+            appendText(getSourceSlice(token), true);
+        else
+            appendText(token.rawText(), true);
+    }
 
     return *this;
 }
@@ -125,10 +129,94 @@ std::string SyntaxPrinter::printFile(const SyntaxTree& tree) {
         .str();
 }
 
+void SyntaxPrinter::printFile(const SyntaxTree& tree,
+                              const std::function<void(std::string_view)>& sink) {
+    SyntaxPrinter(tree.sourceManager())
+        .setIncludeDirectives(true)
+        .setIncludeSkipped(true)
+        .setIncludeTrivia(true)
+        .setIncludePreprocessed(false)
+        .setSquashNewlines(false)
+        .setSliceSink(sink)
+        .print(tree)
+        .flush();
+}
+
+SyntaxPrinter& SyntaxPrinter::flush() {
+    if (!outputSink)
+        return *this;
+
+    if (sliceMode) {
+        if (!pendingSlice.empty()) {
+            outputSink(pendingSlice);
+            pendingSlice = {};
+        }
+    }
+    else if (!buffer.empty()) {
+        outputSink(buffer);
+        buffer.clear();
+    }
+    return *this;
+}
+
+std::string_view SyntaxPrinter::getSourceSlice(Token token) {
+    // Keywords and punctuation have their text stored in a static table, so
+    // point back into the source buffer instead if the text there matches.
+    // That keeps unmodified regions contiguous so they can be merged into
+    // a single slice along with their trivia.
+    std::string_view text = token.rawText();
+    auto loc = token.location();
+    if (!sourceManager || text.empty() || !loc.buffer())
+        return text;
+
+    if (loc.buffer() != sliceBuffer) {
+        sliceBuffer = loc.buffer();
+        sliceBufferText = sourceManager->getSourceText(sliceBuffer);
+    }
+
+    size_t offset = loc.offset();
+    if (offset + text.size() <= sliceBufferText.size()) {
+        auto sourceText = sliceBufferText.substr(offset, text.size());
+        if (sourceText == text)
+            return sourceText;
+    }
+    return text;
+}
+
+void SyntaxPrinter::write(std::string_view text, bool stable) {
+    if (text.empty())
+        return;
+
+    lastNewline = text.back() == '\n';
+    if (!sliceMode) {
+        buffer.append(text);
+        if (outputSink && buffer.size() >= sinkThreshold)
+            flush();
+        return;
+    }
+
+    if (stable && !pendingSlice.empty() &&
+        pendingSlice.data() + pendingSlice.size() == text.data()) {
+        pendingSlice = std::string_view(pendingSlice.data(), pendingSlice.size() + text.size());
+        return;
+    }
+
+    flush();
+    if (stable)
+        pendingSlice = text;
+    else
+        outputSink(text);
+}
+
 SyntaxPrinter& SyntaxPrinter::append(std::string_view text) {
+    appendText(text, false);
+    return *this;
+}
+
+void SyntaxPrinter::appendText(std::string_view text, bool stable) {
     if (!squashNewlines) {
-        buffer.append(text);
-        return *this;
+        write(text, stable);
+        return;
     }
 
     bool carriage = false;
@@ -154,15 +242,19 @@ SyntaxPrinter& SyntaxPrinter::append(std::string_view text) {
         text = text.substr(i);
     }
 
-    if (buffer.empty() || buffer.back() != '\n') {
-        if (carriage)
-            buffer.push_back('\r');
-        if (newline)
-            buffer.push_back('\n');
+    // The last character we printed may already have been handed off
+    // to the output sink, so it's tracked separately from the buffer.
+    if (!lastNewline) {
+        static constexpr std::string_view newlineText = "\r\n";
+        if (carriage && newline)
+            write(newlineText, true);
+        else if (carriage)
+            write(newlineText.substr(0, 1), true);
+        else if (newline)
+            write(newlineText.substr(1), true);
     }
 
-    buffer.append(text);
-    return *this;
+    write(text, stable);
 }
 
 } // namespace slang::syntax
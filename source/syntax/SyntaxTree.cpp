@@ -10,6 +10,7 @@
 #include "slang/parsing/Parser.h"
 #include "slang/parsing/ParserMetadata.h"
 #include "slang/parsing/Preprocessor.h"
+#include "slang/syntax/AllSyntax.h"
 #include "slang/text/SourceManager.h"
 #include "slang/util/TimeTrace.h"
 
@@ -116,6 +117,41 @@ std::shared_ptr<SyntaxTree> SyntaxTree::fromBuffers(std::span<const SourceBuffer
     return create(sourceManager, buffers, options, inheritedMacros, false);
 }
 
+std::shared_ptr<SyntaxTree> SyntaxTree::fromTextEdit(const SyntaxTree& oldTree, size_t offset,
+                                                     size_t length, std::string_view newText,
+                                                     std::string_view name,
+                                                     std::string_view path) {
+    auto oldText = oldTree.sourceMan.getSourceText(
+        oldTree.root().getLastToken().location().buffer());
+    if (!oldText.empty() && oldText.back() == '\0')
+        oldText.remove_suffix(1);
+
+    if (offset > oldText.size() || length > oldText.size() - offset)
+        SLANG_THROW(std::invalid_argument("edit range is outside of the tree's source text"));
+
+    std::string text;
+    text.reserve(oldText.size() - length + newText.size());
+    text.append(oldText.substr(0, offset));
+    text.append(newText);
+    text.append(oldText.substr(offset + length));
+
+    SourceBuffer buffer = oldTree.sourceMan.assignText(path, text, {}, oldTree.library);
+    if (!buffer)
+        return nullptr;
+
+    if (!name.empty())
+        oldTree.sourceMan.addLineDirective(SourceLocation(buffer.id, 0), 2, name, 0);
+
+    auto result = reparseEdit(oldTree, buffer, offset, length, newText);
+    if (!result) {
+        result = create(oldTree.sourceMan, std::span(&buffer, 1), oldTree.options_, {},
+                        oldTree.root().kind != SyntaxKind::CompilationUnit);
+    }
+
+    result->isLibraryUnit = oldTree.isLibraryUnit;
+    return result;
+}
+
 SourceManager& SyntaxTree::getDefaultSourceManager() {
     static SourceManager instance;
     return instance;
@@ -175,6 +211,648 @@ std::shared_ptr<SyntaxTree> SyntaxTree::create(SourceManager& sourceManager,
                        parser.getMetadata(), preprocessor.getDefinedMacros(), options));
 }
 
+namespace {
+
+// Sets a child of a syntax node of any kind.
+struct ChildSetter {
+    size_t index;
+    TokenOrSyntax child;
+
+    template<typename T>
+    void visit(T& node) {
+        if constexpr (requires { node.setChild(index, child); })
+            node.setChild(index, child);
+        else
+            SLANG_UNREACHABLE;
+    }
+};
+
+// Builds the syntax for an edited copy of a tree's source text out of the old
+// tree's nodes. Only the nodes on the path from the root down to the reparsed
+// member get copied, along with whatever is needed to keep the first and last
+// tokens of each copied node in the new buffer so that source ranges never span
+// two buffers. Every other subtree is shared with the old tree. Tokens hold
+// absolute offsets, so subtrees after the edit can only be shared when the edit
+// doesn't move any of the text after it; otherwise they are copied and their
+// tokens shifted by the change in length.
+struct EditSpine {
+    EditSpine(BumpAllocator& alloc, std::span<const BufferID> oldBuffers, BufferID newBuffer,
+              size_t editStart, size_t editEnd, ptrdiff_t delta, bool shareAfterEdit) :
+        alloc(alloc), oldBuffers(oldBuffers), newBuffer(newBuffer), editStart(editStart),
+        editEnd(editEnd), delta(delta), shareAfterEdit(shareAfterEdit) {}
+
+    BumpAllocator& alloc;
+
+    // The buffers that tokens of the old tree can live in. Text edits produce
+    // trees that share nodes with the tree they came from, so this is the new
+    // buffer of each edit in the chain; the text before each edit (and after it,
+    // for edits that didn't move anything) is the same in all of them.
+    std::span<const BufferID> oldBuffers;
+    BufferID newBuffer;
+    size_t editStart;
+    size_t editEnd;
+    ptrdiff_t delta;
+    bool shareAfterEdit;
+
+    // Maps nodes of the old tree to their copies in the new one.
+    flat_hash_map<const SyntaxNode*, SyntaxNode*> copies;
+
+    // The set of nodes that belong to the new tree and are safe to modify.
+    flat_hash_set<const SyntaxNode*> fresh;
+
+    // Set when we find a token that can't simply be moved to the new buffer,
+    // such as from a macro expansion or include, or a directive in its trivia
+    // that changes lexer state.
+    bool failed = false;
+
+    bool isOldBuffer(BufferID buffer) const {
+        return std::ranges::find(oldBuffers, buffer) != oldBuffers.end();
+    }
+
+    SourceLocation map(SourceLocation loc) const {
+        if (!isOldBuffer(loc.buffer()))
+            return loc;
+
+        size_t offset = loc.offset();
+        if (offset >= editEnd)
+            offset = size_t(ptrdiff_t(offset) + delta);
+        else if (offset > editStart)
+            offset = editStart;
+
+        return SourceLocation(newBuffer, offset);
+    }
+
+    template<typename T>
+    const T* remap(const T* node) const {
+        if (auto it = copies.find(node); it != copies.end())
+            return &it->second->template as<T>();
+        return node;
+    }
+
+    // Makes a shallow copy of a node from the old tree. Lists, including any
+    // that are embedded by value in the copied node, get their own backing
+    // storage so that the copy can be modified without touching the old tree.
+    SyntaxNode* copy(const SyntaxNode& node) {
+        auto result = clone(node, alloc);
+        adopt(*result, node);
+        return result;
+    }
+
+    void adopt(SyntaxNode& copy, const SyntaxNode& orig) {
+        copies.emplace(&orig, &copy);
+        fresh.emplace(&copy);
+
+        if (SyntaxListBase::isKind(copy.kind)) {
+            auto& list = static_cast<SyntaxListBase&>(copy);
+            SmallVector<TokenOrSyntax> children;
+            for (size_t i = 0; i < list.getChildCount(); i++)
+                children.push_back(list.getChild(i));
+
+            auto parent = list.parent;
+            list.resetAll(alloc, children);
+            list.parent = parent;
+            return;
+        }
+
+        for (size_t i = 0; i < copy.getChildCount(); i++) {
+            auto child = copy.childNode(i);
+            if (child && child != orig.childNode(i)) {
+                child->parent = &copy;
+                adopt(*child, *orig.childNode(i));
+            }
+        }
+    }
+
+    void replaceChild(SyntaxNode& node, size_t index, SyntaxNode* child) {
+        // Items in a list are parented to the node that owns the list.
+        child->parent = SyntaxListBase::isKind(node.kind) ? node.parent : &node;
+        ChildSetter setter{index, child};
+        node.visit(setter);
+    }
+
+    // Finishes off a node copied from the old tree. @a path holds the remaining
+    // child indices that lead down to the reparsed member if the node is on the
+    // spine, and @a afterEdit is set if the whole node comes after the edit.
+    void finish(SyntaxNode& node, bool afterEdit, std::span<const size_t> path) {
+        auto [first, last] = getBoundaryChildren(node);
+        for (size_t i = 0; i < node.getChildCount() && !failed; i++) {
+            auto child = node.childNode(i);
+            if (!child) {
+                if (auto token = node.childTokenPtr(i); token && *token)
+                    relocate(*token);
+                continue;
+            }
+
+            if (!path.empty() && i == path[0]) {
+                if (path.size() > 1)
+                    finish(*child, false, path.subspan(1));
+                continue;
+            }
+
+            bool childAfterEdit = afterEdit || (!path.empty() && i > path[0]);
+            if (fresh.contains(child)) {
+                finish(*child, childAfterEdit, {});
+            }
+            else if (childAfterEdit && !shareAfterEdit) {
+                replaceChild(node, i, cloneAll(*child));
+            }
+            else if (i == first || i == last) {
+                auto result = copy(*child);
+                replaceChild(node, i, result);
+                finish(*result, childAfterEdit, {});
+            }
+        }
+    }
+
+    SyntaxNode* cloneAll(const SyntaxNode& node) {
+        auto result = copy(node);
+        relocateAll(*result);
+        return result;
+    }
+
+    void relocateAll(SyntaxNode& node) {
+        for (size_t i = 0; i < node.getChildCount() && !failed; i++) {
+            auto child = node.childNode(i);
+            if (!child) {
+                if (auto token = node.childTokenPtr(i); token && *token)
+                    relocate(*token);
+            }
+            else if (fresh.contains(child)) {
+                relocateAll(*child);
+            }
+            else {
+                replaceChild(node, i, cloneAll(*child));
+            }
+        }
+    }
+
+    // Relocates the tokens of a node that is already owned by the new tree,
+    // such as a directive in the trivia of a copied token.
+    void relocateTokens(SyntaxNode& node) {
+        for (size_t i = 0; i < node.getChildCount() && !failed; i++) {
+            if (auto child = node.childNode(i))
+                relocateTokens(*child);
+            else if (auto token = node.childTokenPtr(i); token && *token)
+                relocate(*token);
+        }
+    }
+
+    void relocate(Token& token) {
+        auto loc = token.location();
+        if (!isOldBuffer(loc.buffer())) {
+            if (loc != SourceLocation::NoLocation)
+                failed = true;
+            return;
+        }
+
+        // Tokens share their trivia with the old tree, so take a deep copy
+        // before touching any directives in it.
+        token = token.deepClone(alloc);
+        for (auto& trivia : token.trivia()) {
+            switch (trivia.kind) {
+                case TriviaKind::Directive:
+                    if (!isRelocatable(trivia.syntax()->kind)) {
+                        failed = true;
+                        return;
+                    }
+                    relocateTokens(*trivia.syntax());
+                    break;
+                case TriviaKind::SkippedSyntax:
+                    relocateTokens(*trivia.syntax());
+                    break;
+                case TriviaKind::SkippedTokens:
+                    failed = true;
+                    return;
+                default:
+                    break;
+            }
+        }
+
+        token = token.withLocation(alloc, map(loc));
+    }
+
+    void relocate(Diagnostic& diag) const {
+        diag.location = map(diag.location);
+        for (auto& range : diag.ranges)
+            range = SourceRange(map(range.start()), map(range.end()));
+        for (auto& note : diag.notes)
+            relocate(note);
+    }
+
+    // Returns the indices of the children holding the first and last tokens of
+    // the given node.
+    static std::pair<size_t, size_t> getBoundaryChildren(const SyntaxNode& node) {
+        auto hasTokens = [&](size_t index) {
+            if (auto child = node.childNode(index))
+                return bool(child->getFirstToken());
+            return bool(node.childToken(index));
+        };
+
+        size_t count = node.getChildCount();
+        size_t first = 0;
+        while (first < count && !hasTokens(first))
+            first++;
+
+        size_t last = count;
+        while (last > first && !hasTokens(last - 1))
+            last--;
+
+        return {first, last ? last - 1 : 0};
+    }
+
+    static bool isRelocatable(SyntaxKind kind) {
+        switch (kind) {
+            case SyntaxKind::DefineDirective:
+            case SyntaxKind::UndefDirective:
+            case SyntaxKind::UndefineAllDirective:
+            case SyntaxKind::IfDefDirective:
+            case SyntaxKind::IfNDefDirective:
+            case SyntaxKind::ElsIfDirective:
+            case SyntaxKind::ElseDirective:
+            case SyntaxKind::EndIfDirective:
+            case SyntaxKind::TimeScaleDirective:
+            case SyntaxKind::DefaultNetTypeDirective:
+            case SyntaxKind::UnconnectedDriveDirective:
+            case SyntaxKind::NoUnconnectedDriveDirective:
+            case SyntaxKind::CellDefineDirective:
+            case SyntaxKind::EndCellDefineDirective:
+            case SyntaxKind::ResetAllDirective:
+                return true;
+            default:
+                return false;
+        }
+    }
+};
+
+// Walks a member that is being reparsed on its own, collecting the nodes
+// and instantiations in it and checking whether it can safely be reparsed
+// without the rest of the file.
+struct MemberScan {
+    explicit MemberScan(std::span<const BufferID> buffers) : buffers(buffers) {}
+
+    std::span<const BufferID> buffers;
+    flat_hash_set<const SyntaxNode*> nodes;
+    flat_hash_set<std::string_view> instanceNames;
+    bool pastFirstToken = false;
+
+    // Cleared if the member contains preprocessor directives, text disabled by
+    // conditional directives, or tokens that came from a macro expansion or
+    // include file; any of those means the member can't be lexed again in
+    // isolation.
+    bool reparseable = true;
+
+    void scan(const SyntaxNode& node) {
+        nodes.emplace(&node);
+        if (node.kind == SyntaxKind::HierarchyInstantiation)
+            instanceNames.emplace(node.as<HierarchyInstantiationSyntax>().type.valueText());
+
+        for (size_t i = 0; i < node.getChildCount(); i++) {
+            if (auto child = node.childNode(i))
+                scan(*child);
+            else if (auto token = node.childToken(i))
+                scan(token);
+        }
+    }
+
+    void scan(Token token) {
+        // The first token's leading trivia comes before the member
+        // and is carried over as is.
+        if (std::exchange(pastFirstToken, true)) {
+            for (auto& trivia : token.trivia()) {
+                if (trivia.kind == TriviaKind::Directive ||
+                    trivia.kind == TriviaKind::DisabledText) {
+                    reparseable = false;
+                }
+            }
+        }
+
+        if (std::ranges::find(buffers, token.location().buffer()) == buffers.end())
+            reparseable = false;
+    }
+};
+
+// Builds one of the metadata lists for an edited tree: entries from the old
+// tree keep their order and point at the copied node where one was made,
+// entries from the replaced member are dropped, and the reparsed member's
+// entries go in their place.
+template<typename T>
+std::vector<const T*> spliceMetadata(const std::vector<const T*>& oldList,
+                                     const std::vector<const T*>& memberList,
+                                     const MemberScan& scan, const EditSpine& spine,
+                                     size_t memberEnd) {
+    std::vector<const T*> result;
+    result.reserve(oldList.size() + memberList.size());
+
+    std::optional<size_t> insertAt;
+    for (auto entry : oldList) {
+        if (scan.nodes.contains(entry)) {
+            if (!insertAt)
+                insertAt = result.size();
+            continue;
+        }
+
+        if (!insertAt) {
+            auto loc = entry->getFirstToken().location();
+            if (spine.isOldBuffer(loc.buffer()) && loc.offset() >= memberEnd)
+                insertAt = result.size();
+        }
+        result.push_back(spine.remap(entry));
+    }
+
+    result.insert(result.begin() + ptrdiff_t(insertAt.value_or(result.size())),
+                  memberList.begin(), memberList.end());
+    return result;
+}
+
+// Returns true if the given child of a list owned by @a owner is a member
+// that we know how to reparse on its own.
+bool isReparseableMember(const SyntaxNode& owner, const SyntaxNode& child) {
+    switch (owner.kind) {
+        case SyntaxKind::CompilationUnit:
+        case SyntaxKind::ModuleDeclaration:
+        case SyntaxKind::InterfaceDeclaration:
+        case SyntaxKind::ProgramDeclaration:
+        case SyntaxKind::PackageDeclaration:
+        case SyntaxKind::ClassDeclaration:
+            return MemberSyntax::isKind(child.kind);
+        case SyntaxKind::SequentialBlockStatement:
+        case SyntaxKind::ParallelBlockStatement:
+            return StatementSyntax::isKind(child.kind);
+        default:
+            return false;
+    }
+}
+
+// Returns true if replacing @a oldText with @a newText leaves every line
+// break where it was, so that nothing after the edit moves.
+bool keepsLayout(std::string_view oldText, std::string_view newText) {
+    if (oldText.size() != newText.size())
+        return false;
+
+    for (size_t i = 0; i < oldText.size(); i++) {
+        bool oldBreak = oldText[i] == '\n' || oldText[i] == '\r';
+        bool newBreak = newText[i] == '\n' || newText[i] == '\r';
+        if (oldBreak != newBreak)
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+std::shared_ptr<SyntaxTree> SyntaxTree::reparseEdit(const SyntaxTree& oldTree,
+                                                    const SourceBuffer& buffer, size_t offset,
+                                                    size_t length, std::string_view newText) {
+    // Each edited tree keeps the tree it was derived from alive, since it shares
+    // syntax nodes with it. Parse from scratch once in a while so that long runs
+    // of edits don't hold on to every version of the file.
+    static constexpr size_t MaxEditChain = 16;
+
+    auto& oldRoot = oldTree.root();
+    if (oldRoot.kind != SyntaxKind::CompilationUnit || !oldTree.metadata->deferredBodies.empty() ||
+        oldTree.editBuffers.size() >= MaxEditChain) {
+        return nullptr;
+    }
+
+    auto baseTree = oldTree.weak_from_this().lock();
+    if (!baseTree)
+        return nullptr;
+
+    // Any edit that touches a directive or macro usage can change preprocessor
+    // state for the rest of the file, so those always get a full parse.
+    const BufferID oldBuffer = oldRoot.getLastToken().location().buffer();
+    auto oldText = oldTree.sourceMan.getSourceText(oldBuffer);
+    auto replacedText = oldText.substr(offset, length);
+    if (newText.find('`') != std::string_view::npos ||
+        replacedText.find('`') != std::string_view::npos) {
+        return nullptr;
+    }
+
+    std::vector<BufferID> editBuffers = oldTree.editBuffers;
+    if (editBuffers.empty())
+        editBuffers.push_back(oldBuffer);
+
+    auto isOldBuffer = [&](SourceLocation loc) {
+        return std::ranges::find(editBuffers, loc.buffer()) != editBuffers.end();
+    };
+
+    // Find the smallest member that strictly encloses the edit. The edit must
+    // start after the member's first token begins so that the leading trivia
+    // and everything lexed before it is unaffected. We remember the path of
+    // child indices so that we can find the same spot in the new tree.
+    SmallVector<size_t, 16> path;
+    size_t memberDepth = 0;
+    const SyntaxNode* member = nullptr;
+    const SyntaxNode* owner = nullptr;
+    const SyntaxNode* context = nullptr;
+    size_t memberStart = 0, memberEnd = 0;
+
+    const SyntaxNode* node = &oldRoot;
+    while (node) {
+        const SyntaxNode* next = nullptr;
+        for (size_t i = 0; i < node->getChildCount(); i++) {
+            auto child = node->childNode(i);
+            if (!child)
+                continue;
+
+            auto first = child->getFirstToken();
+            auto last = child->getLastToken();
+            if (!first || !last || !isOldBuffer(first.location()) ||
+                !isOldBuffer(last.location())) {
+                continue;
+            }
+
+            size_t start = first.location().offset();
+            size_t end = last.location().offset() + last.rawText().size();
+            if (start < offset && offset + length <= end) {
+                if (node->kind == SyntaxKind::SyntaxList && owner &&
+                    isReparseableMember(*owner, *child)) {
+                    member = child;
+                    context = owner;
+                    memberDepth = path.size() + 1;
+                    memberStart = start;
+                    memberEnd = end;
+                }
+
+                path.push_back(i);
+                next = child;
+                break;
+            }
+        }
+
+        owner = node;
+        node = next;
+    }
+
+    if (!member)
+        return nullptr;
+
+    MemberScan oldScan{editBuffers};
+    oldScan.scan(*member);
+    if (!oldScan.reparseable)
+        return nullptr;
+
+    BumpAllocator alloc;
+    Diagnostics diagnostics;
+    Preprocessor preprocessor(oldTree.sourceMan, alloc, diagnostics, oldTree.options_);
+    preprocessor.pushSource(buffer, memberStart);
+
+    Parser parser(preprocessor, oldTree.options_);
+    SyntaxNode* newMember;
+    if (context->kind == SyntaxKind::ClassDeclaration) {
+        auto& classDecl = context->as<ClassDeclarationSyntax>();
+        newMember = parser.parseSingleClassMember(
+            classDecl.virtualOrInterface.kind == TokenKind::InterfaceKeyword,
+            classDecl.extendsClause != nullptr);
+    }
+    else if (StatementSyntax::isKind(member->kind)) {
+        newMember = &parser.parseStatement();
+    }
+    else {
+        newMember = parser.parseSingleMember(context->kind);
+    }
+
+    // Errors in the new text may depend on the surrounding context, so we
+    // only accept a clean parse that ends exactly where the old member did.
+    const ptrdiff_t delta = ptrdiff_t(newText.size()) - ptrdiff_t(length);
+    if (!newMember || !diagnostics.empty())
+        return nullptr;
+
+    auto newLast = newMember->getLastToken();
+    if (!newLast || newLast.location().buffer() != buffer.id ||
+        newLast.location().offset() + newLast.rawText().size() !=
+            size_t(ptrdiff_t(memberEnd) + delta)) {
+        return nullptr;
+    }
+
+    // The parser started out with default preprocessor state, so the state it
+    // recorded for any declarations in the member is wrong. The member has no
+    // directives of its own, so the right state is whatever was in effect for
+    // declarations in the old member; if there weren't any, we don't know it.
+    auto memberMeta = parser.getMetadata();
+    auto& oldMeta = *oldTree.metadata;
+    std::optional<ParserMetadata::Node> memberState;
+    for (auto& [oldNode, state] : oldMeta.nodeMap) {
+        if (oldScan.nodes.contains(oldNode))
+            memberState = state;
+    }
+
+    if (!memberMeta.nodeMap.empty() && !memberState)
+        return nullptr;
+
+    EditSpine spine{alloc,
+                    editBuffers,
+                    buffer.id,
+                    offset,
+                    offset + length,
+                    delta,
+                    keepsLayout(replacedText, newText)};
+
+    auto root = spine.copy(oldRoot);
+    SyntaxNode* list = root;
+    for (size_t i = 0; i < memberDepth - 1; i++) {
+        auto index = path[i];
+        auto child = list->childNode(index);
+        if (!spine.fresh.contains(child)) {
+            child = spine.copy(*child);
+            spine.replaceChild(*list, index, child);
+        }
+        list = child;
+    }
+
+    auto firstToken = newMember->getFirstTokenPtr();
+    *firstToken = firstToken->withTrivia(alloc, member->getFirstToken().trivia());
+    spine.replaceChild(*list, path[memberDepth - 1], newMember);
+
+    spine.finish(*root, false, std::span<const size_t>(path).subspan(0, memberDepth));
+    if (spine.failed)
+        return nullptr;
+
+    for (auto& diag : oldTree.diagnosticsBuffer) {
+        if (isOldBuffer(diag.location) && diag.location.offset() >= memberStart &&
+            diag.location.offset() < memberEnd) {
+            continue;
+        }
+
+        auto& newDiag = diagnostics.emplace_back(diag);
+        spine.relocate(newDiag);
+    }
+
+    // Carry the old tree's metadata over instead of walking the whole new tree.
+    ParserMetadata metadata;
+    for (auto& [oldNode, state] : oldMeta.nodeMap) {
+        if (!oldScan.nodes.contains(oldNode))
+            metadata.nodeMap.emplace(spine.remap(oldNode), state);
+    }
+
+    for (auto& [newNode, _] : memberMeta.nodeMap)
+        metadata.nodeMap.emplace(newNode, *memberState);
+
+    metadata.classPackageNames = spliceMetadata(oldMeta.classPackageNames,
+                                                memberMeta.classPackageNames, oldScan, spine,
+                                                memberEnd);
+    metadata.packageImports = spliceMetadata(oldMeta.packageImports, memberMeta.packageImports,
+                                             oldScan, spine, memberEnd);
+    metadata.classDecls = spliceMetadata(oldMeta.classDecls, memberMeta.classDecls, oldScan,
+                                         spine, memberEnd);
+    metadata.interfacePorts = spliceMetadata(oldMeta.interfacePorts, memberMeta.interfacePorts,
+                                             oldScan, spine, memberEnd);
+
+    // Whether a name counts as a global instance depends on the modules declared
+    // around it, so if the member's instantiations changed just work it out again.
+    MemberScan newScan{std::span(&buffer.id, 1)};
+    newScan.scan(*newMember);
+    if (newScan.instanceNames == oldScan.instanceNames)
+        metadata.globalInstances = oldMeta.globalInstances;
+    else
+        metadata.globalInstances = ParserMetadata::fromSyntax(*root).globalInstances;
+
+    metadata.eofToken = root->as<CompilationUnitSyntax>().endOfFile;
+    metadata.hasDefparams = oldMeta.hasDefparams || memberMeta.hasDefparams;
+    metadata.hasBindDirectives = oldMeta.hasBindDirectives || memberMeta.hasBindDirectives;
+
+    // Macros hold on to locations in the buffer they were defined in, which
+    // is still alive, so they can simply be shared with the old tree.
+    std::vector<const DefineDirectiveSyntax*> macros = oldTree.macros;
+
+    auto result = std::shared_ptr<SyntaxTree>(new SyntaxTree(root, oldTree.library,
+                                                             oldTree.sourceMan, std::move(alloc),
+                                                             std::move(diagnostics),
+                                                             std::move(metadata),
+                                                             std::move(macros), oldTree.options_));
+
+    editBuffers.push_back(buffer.id);
+    result->editBuffers = std::move(editBuffers);
+    result->baseTree = std::move(baseTree);
+    return result;
+}
+
+const ModuleDeclarationSyntax* SyntaxTree::parseDeferredBody(const ModuleDeclarationSyntax& syntax,
+                                                             BumpAllocator& alloc,
+                                                             Diagnostics& diagnostics) const {
+    if (!metadata->deferredBodies.contains(&syntax))
+        return nullptr;
+
+    // The parser only defers declarations that came straight from the source
+    // text, so we can start right at the first token and parse it again.
+    auto start = syntax.getFirstToken().location();
+    SourceBuffer buffer{sourceMan.getSourceText(start.buffer()), library, start.buffer()};
+
+    Bag options = options_;
+    options.insertOrGet<ParserOptions>().deferModuleBodies = false;
+
+    Preprocessor preprocessor(sourceMan, alloc, diagnostics, options);
+    preprocessor.pushSource(buffer, start.offset());
+
+    Parser parser(preprocessor, options);
+    auto& result = parser.parseModule();
+    if (result.kind != syntax.kind)
+        return nullptr;
+
+    result.parent = syntax.parent;
+    return &result.as<ModuleDeclarationSyntax>();
+}
+
 std::shared_ptr<SyntaxTree> SyntaxTree::fromLibraryMapFile(std::string_view path,
                                                            SourceManager& sourceManager,
                                                            const Bag& options) {
@@ -146,6 +146,28 @@ struct CloneVisitor {
 
 namespace slang::syntax::detail {
 
+void ChangeCollection::merge(ChangeCollection&& other) {
+    auto mergeInserts = [](InsertChangeMap& dest, InsertChangeMap& src) {
+        for (auto& [node, changes] : src) {
+            auto& list = dest[node];
+            list.insert(list.end(), std::make_move_iterator(changes.begin()),
+                        std::make_move_iterator(changes.end()));
+        }
+    };
+
+    mergeInserts(insertBefore, other.insertBefore);
+    mergeInserts(insertAfter, other.insertAfter);
+    mergeInserts(listInsertAtFront, other.listInsertAtFront);
+    mergeInserts(listInsertAtBack, other.listInsertAtBack);
+
+    for (auto& [node, change] : other.removeOrReplace) {
+        if (!removeOrReplace.emplace(node, change).second)
+            SLANG_THROW(std::logic_error("Node only permit one remove/replace operation"));
+    }
+
+    other.clear();
+}
+
 std::shared_ptr<SyntaxTree> transformTree(BumpAllocator&& alloc,
                                           const std::shared_ptr<SyntaxTree>& tree,
                                           const ChangeCollection& commits,
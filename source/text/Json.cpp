@@ -24,6 +24,11 @@ std::string_view JsonWriter::view() const {
     return std::string_view(buffer->data(), findLastComma());
 }
 
+void JsonWriter::clear() {
+    buffer->clear();
+    currentIndent = 0;
+}
+
 void JsonWriter::startObject() {
     buffer->append("{");
     if (pretty) {
@@ -21,8 +21,8 @@ static const fs::path emptyPath;
 
 SourceManager::SourceManager() {
     // add a dummy entry to the start of the directory list so that our file IDs line up
-    FileInfo file;
-    bufferEntries.emplace_back(file);
+    std::unique_lock lock(mutex);
+    bufferEntries.append<FileInfo>();
 }
 
 std::error_code SourceManager::addSystemDirectories(std::string_view pattern) {
@@ -48,13 +48,12 @@ std::error_code SourceManager::addUserDirectories(std::string_view pattern) {
 }
 
 size_t SourceManager::getLineNumber(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
-    size_t rawLineNumber = getRawLineNumber(fileLocation, lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
+    size_t rawLineNumber = getRawLineNumber(fileLocation);
     if (rawLineNumber == 0)
         return 0;
 
-    auto info = getFileInfo(fileLocation.buffer(), lock);
+    auto info = getFileInfo(fileLocation.buffer());
 
     auto lineDirective = info->getPreviousLineDirective(rawLineNumber);
     if (!lineDirective)
@@ -64,8 +63,7 @@ size_t SourceManager::getLineNumber(SourceLocation location) const {
 }
 
 size_t SourceManager::getColumnNumber(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(location.buffer(), lock);
+    auto info = getFileInfo(location.buffer());
     if (!info || !info->data)
         return 0;
 
@@ -80,17 +78,16 @@ size_t SourceManager::getColumnNumber(SourceLocation location) const {
 }
 
 std::string_view SourceManager::getFileName(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
-    auto info = getFileInfo(fileLocation.buffer(), lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
+    auto info = getFileInfo(fileLocation.buffer());
     if (!info || !info->data)
         return "";
 
     // Avoid computing line offsets if we just need a name of `line-less file
-    if (info->lineDirectives.empty())
+    if (!info->hasLineDirectives())
         return info->data->name;
 
-    size_t rawLine = getRawLineNumber(fileLocation, lock);
+    size_t rawLine = getRawLineNumber(fileLocation);
     auto lineDirective = info->getPreviousLineDirective(rawLine);
     if (!lineDirective)
         return info->data->name;
@@ -99,8 +96,7 @@ std::string_view SourceManager::getFileName(SourceLocation location) const {
 }
 
 std::string_view SourceManager::getRawFileName(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info || !info->data)
         return "";
 
@@ -108,8 +104,7 @@ std::string_view SourceManager::getRawFileName(BufferID buffer) const {
 }
 
 const fs::path& SourceManager::getFullPath(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info || !info->data)
         return emptyPath;
 
@@ -117,8 +112,7 @@ const fs::path& SourceManager::getFullPath(BufferID buffer) const {
 }
 
 SourceLocation SourceManager::getIncludedFrom(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info)
         return SourceLocation();
 
@@ -126,8 +120,7 @@ SourceLocation SourceManager::getIncludedFrom(BufferID buffer) const {
 }
 
 const SourceLibrary* SourceManager::getLibraryFor(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info)
         return nullptr;
 
@@ -135,16 +128,10 @@ const SourceLibrary* SourceManager::getLibraryFor(BufferID buffer) const {
 }
 
 std::string_view SourceManager::getMacroName(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    while (isMacroArgLocImpl(location, lock))
-        location = getExpansionRangeImpl(location, lock).start();
+    while (isMacroArgLocImpl(location))
+        location = getExpansionRangeImpl(location).start();
 
-    auto buffer = location.buffer();
-    if (!buffer)
-        return {};
-
-    SLANG_ASSERT(buffer.getId() < bufferEntries.size());
-    auto info = std::get_if<ExpansionInfo>(&bufferEntries[buffer.getId()]);
+    auto info = getExpansionInfo(location.buffer());
     if (!info)
         return {};
 
@@ -155,18 +142,15 @@ bool SourceManager::isFileLoc(SourceLocation location) const {
     if (location.buffer() == SourceLocation::NoLocation.buffer())
         return false;
 
-    std::shared_lock lock(mutex);
-    return getFileInfo(location.buffer(), lock) != nullptr;
+    return getFileInfo(location.buffer()) != nullptr;
 }
 
 bool SourceManager::isMacroLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return isMacroLocImpl(location, lock);
+    return isMacroLocImpl(location);
 }
 
 bool SourceManager::isMacroArgLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return isMacroArgLocImpl(location, lock);
+    return isMacroArgLocImpl(location);
 }
 
 bool SourceManager::isIncludedFileLoc(SourceLocation location) const {
@@ -178,35 +162,29 @@ bool SourceManager::isPreprocessedLoc(SourceLocation location) const {
 }
 
 SourceLocation SourceManager::getExpansionLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getExpansionRangeImpl(location, lock).start();
+    return getExpansionRangeImpl(location).start();
 }
 
 SourceRange SourceManager::getExpansionRange(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getExpansionRangeImpl(location, lock);
+    return getExpansionRangeImpl(location);
 }
 
 SourceLocation SourceManager::getOriginalLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getOriginalLocImpl(location, lock);
+    return getOriginalLocImpl(location);
 }
 
 SourceLocation SourceManager::getFullyOriginalLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    while (isMacroLocImpl(location, lock))
-        location = getOriginalLocImpl(location, lock);
+    while (isMacroLocImpl(location))
+        location = getOriginalLocImpl(location);
     return location;
 }
 
 SourceLocation SourceManager::getFullyExpandedLoc(SourceLocation location) const {
-    std::shared_lock lock(mutex);
-    return getFullyExpandedLocImpl(location, lock);
+    return getFullyExpandedLocImpl(location);
 }
 
 std::string_view SourceManager::getSourceText(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info || !info->data)
         return "";
 
@@ -215,8 +193,7 @@ std::string_view SourceManager::getSourceText(BufferID buffer) const {
 }
 
 uint64_t SourceManager::getSortKey(BufferID buffer) const {
-    std::shared_lock lock(mutex);
-    auto info = getFileInfo(buffer, lock);
+    auto info = getFileInfo(buffer);
     if (!info)
         return uint64_t(buffer.getId()) << 32;
 
@@ -227,8 +204,8 @@ SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
                                                  SourceRange expansionRange, bool isMacroArg) {
     std::unique_lock lock(mutex);
 
-    bufferEntries.emplace_back(ExpansionInfo(originalLoc, expansionRange, isMacroArg));
-    return SourceLocation(BufferID((uint32_t)(bufferEntries.size() - 1), ""sv), 0);
+    auto index = bufferEntries.append<ExpansionInfo>(originalLoc, expansionRange, isMacroArg);
+    return SourceLocation(BufferID(index, ""sv), 0);
 }
 
 SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
@@ -236,8 +213,8 @@ SourceLocation SourceManager::createExpansionLoc(SourceLocation originalLoc,
                                                  std::string_view macroName) {
     std::unique_lock lock(mutex);
 
-    bufferEntries.emplace_back(ExpansionInfo(originalLoc, expansionRange, macroName));
-    return SourceLocation(BufferID((uint32_t)(bufferEntries.size() - 1), macroName), 0);
+    auto index = bufferEntries.append<ExpansionInfo>(originalLoc, expansionRange, macroName);
+    return SourceLocation(BufferID(index, macroName), 0);
 }
 
 SourceBuffer SourceManager::assignText(std::string_view text, SourceLocation includedFrom,
@@ -313,12 +290,8 @@ SourceManager::BufferOrError SourceManager::readHeader(
 
     // search relative to the current file
     const fs::path* currFileDir = nullptr;
-    {
-        std::shared_lock lock(mutex);
-        auto info = getFileInfo(includedFrom.buffer(), lock);
-        if (info && info->data)
-            currFileDir = info->data->directory;
-    }
+    if (auto info = getFileInfo(includedFrom.buffer()); info && info->data)
+        currFileDir = info->data->directory;
 
     if (currFileDir) {
         auto result = openCached(*currFileDir / p, includedFrom, library);
@@ -354,9 +327,8 @@ SourceManager::BufferOrError SourceManager::readHeader(
 
 void SourceManager::addLineDirective(SourceLocation location, size_t lineNum, std::string_view name,
                                      uint8_t level) {
-    std::unique_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
-    FileInfo* info = getFileInfo(fileLocation.buffer(), lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
+    FileInfo* info = getFileInfo(fileLocation.buffer());
     if (!info || !info->data)
         return;
 
@@ -368,15 +340,26 @@ void SourceManager::addLineDirective(SourceLocation location, size_t lineNum, st
     else
         full = fs::path(info->data->name).replace_filename(linePath);
 
-    size_t sourceLineNum = getRawLineNumber(fileLocation, lock);
-    info->lineDirectives.emplace_back(std::string(getU8Str(full)), sourceLineNum, lineNum, level);
+    size_t sourceLineNum = getRawLineNumber(fileLocation);
+
+    // Directives are only ever appended, so readers looking up
+    // earlier ones are never disturbed.
+    std::unique_lock lock(mutex);
+    auto directives = info->lineDirectives.load(std::memory_order_relaxed);
+    if (!directives) {
+        directives = lineDirectiveStorage.emplace_back(std::make_unique<LineDirectiveTable>())
+                         .get();
+        info->lineDirectives.store(directives, std::memory_order_release);
+    }
+
+    directives->append(std::string(getU8Str(full)), sourceLineNum, lineNum, level);
 }
 
 void SourceManager::addDiagnosticDirective(SourceLocation location, std::string_view name,
                                            DiagnosticSeverity severity) {
-    std::unique_lock lock(mutex);
-    SourceLocation fileLocation = getFullyExpandedLocImpl(location, lock);
+    SourceLocation fileLocation = getFullyExpandedLocImpl(location);
 
+    std::unique_lock lock(mutex);
     size_t offset = fileLocation.offset();
     auto& vec = diagDirectives[fileLocation.buffer()];
     if (vec.empty() || offset >= vec.back().offset)
@@ -398,28 +381,33 @@ std::span<const SourceManager::DiagnosticDirectiveInfo> SourceManager::getDiagno
 }
 
 std::vector<BufferID> SourceManager::getAllBuffers() const {
-    std::shared_lock lock(mutex);
     std::vector<BufferID> result;
-    for (size_t i = 1; i < bufferEntries.size(); i++)
-        result.push_back(BufferID((uint32_t)i, ""sv));
+    for (uint32_t i = 1, size = bufferEntries.size(); i < size; i++)
+        result.push_back(BufferID(i, ""sv));
 
     return result;
 }
 
-template<IsLock TLock>
-SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer, TLock&) {
-    if (!buffer || buffer.getId() >= bufferEntries.size())
+SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer) {
+    if (!buffer)
+        return nullptr;
+
+    return std::get_if<FileInfo>(bufferEntries.get(buffer.getId()));
+}
+
+const SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer) const {
+    if (!buffer)
         return nullptr;
 
-    return std::get_if<FileInfo>(&bufferEntries[buffer.getId()]);
+    return std::get_if<FileInfo>(bufferEntries.get(buffer.getId()));
 }
 
-template<IsLock TLock>
-const SourceManager::FileInfo* SourceManager::getFileInfo(BufferID buffer, TLock&) const {
-    if (!buffer || buffer.getId() >= bufferEntries.size())
+const SourceManager::ExpansionInfo* SourceManager::getExpansionInfo(BufferID buffer) const {
+    if (!buffer)
         return nullptr;
 
-    return std::get_if<FileInfo>(&bufferEntries[buffer.getId()]);
+    SLANG_ASSERT(buffer.getId() < bufferEntries.size());
+    return std::get_if<ExpansionInfo>(bufferEntries.get(buffer.getId()));
 }
 
 SourceBuffer SourceManager::createBufferEntry(FileData* fd, SourceLocation includedFrom,
@@ -430,11 +418,11 @@ SourceBuffer SourceManager::createBufferEntry(FileData* fd, SourceLocation inclu
     // If no sort key is provided we use the bufferID, but shifted up
     // so that the bottom 32 bits are reserved for custom sort keys.
     if (sortKey == UINT64_MAX)
-        sortKey = bufferEntries.size() << 32;
+        sortKey = uint64_t(bufferEntries.size()) << 32;
 
-    bufferEntries.emplace_back(FileInfo(fd, library, includedFrom, sortKey));
+    auto index = bufferEntries.append<FileInfo>(fd, library, includedFrom, sortKey);
     return SourceBuffer{std::string_view(fd->mem.data(), fd->mem.size()), library,
-                        BufferID((uint32_t)(bufferEntries.size() - 1), fd->name)};
+                        BufferID(index, fd->name)};
 }
 
 bool SourceManager::isCached(const fs::path& path) const {
@@ -528,35 +516,19 @@ SourceBuffer SourceManager::cacheBuffer(fs::path&& path, std::string&& pathStr,
     return createBufferEntry(fdPtr, includedFrom, library, sortKey, lock);
 }
 
-template<IsLock TLock>
-size_t SourceManager::getRawLineNumber(SourceLocation location, TLock& readLock) const {
-    FileData* fd;
-    {
-        // Separate scope so that info isn't used after it may potentially
-        // get invalidated when we briefly unloack a read lock and grab a
-        // write lock below.
-        const FileInfo* info = getFileInfo(location.buffer(), readLock);
-        if (!info || !info->data)
-            return 0;
-
-        fd = info->data;
-    }
-
-    if (fd->lineOffsets.empty()) {
-        // We need to compute line offsets. If the lock is a write lock then
-        // we can just go ahead and do that; if not we need to unlock the
-        // read lock and grab a write lock.
-        if constexpr (std::is_same_v<TLock, std::shared_lock<std::shared_mutex>>) {
-            readLock.unlock();
-
-            std::unique_lock writeLock(mutex);
-            computeLineOffsets(fd->mem, fd->lineOffsets);
+size_t SourceManager::getRawLineNumber(SourceLocation location) const {
+    const FileInfo* info = getFileInfo(location.buffer());
+    if (!info || !info->data)
+        return 0;
 
-            writeLock.unlock();
-            readLock.lock();
-        }
-        else {
+    FileData* fd = info->data;
+    if (!fd->hasLineOffsets.load(std::memory_order_acquire)) {
+        // We need to compute line offsets. Once they're published
+        // they never change, so only this first call needs the lock.
+        std::unique_lock lock(mutex);
+        if (!fd->hasLineOffsets.load(std::memory_order_relaxed)) {
             computeLineOffsets(fd->mem, fd->lineOffsets);
+            fd->hasLineOffsets.store(true, std::memory_order_release);
         }
     }
 
@@ -572,62 +544,49 @@ size_t SourceManager::getRawLineNumber(SourceLocation location, TLock& readLock)
     return line;
 }
 
-template<IsLock TLock>
-SourceLocation SourceManager::getFullyExpandedLocImpl(SourceLocation location, TLock& lock) const {
-    while (isMacroLocImpl(location, lock)) {
-        if (isMacroArgLocImpl(location, lock))
-            location = getOriginalLocImpl(location, lock);
+SourceLocation SourceManager::getFullyExpandedLocImpl(SourceLocation location) const {
+    while (isMacroLocImpl(location)) {
+        if (isMacroArgLocImpl(location))
+            location = getOriginalLocImpl(location);
         else
-            location = getExpansionRangeImpl(location, lock).start();
+            location = getExpansionRangeImpl(location).start();
     }
     return location;
 }
 
-template<IsLock TLock>
-bool SourceManager::isMacroLocImpl(SourceLocation location, TLock&) const {
+bool SourceManager::isMacroLocImpl(SourceLocation location) const {
     if (location.buffer() == SourceLocation::NoLocation.buffer())
         return false;
 
-    auto buffer = location.buffer();
-    if (!buffer)
-        return false;
-
-    SLANG_ASSERT(buffer.getId() < bufferEntries.size());
-    return std::get_if<ExpansionInfo>(&bufferEntries[buffer.getId()]) != nullptr;
+    return getExpansionInfo(location.buffer()) != nullptr;
 }
 
-template<IsLock TLock>
-bool SourceManager::isMacroArgLocImpl(SourceLocation location, TLock&) const {
+bool SourceManager::isMacroArgLocImpl(SourceLocation location) const {
     if (location == SourceLocation::NoLocation)
         return false;
 
-    auto buffer = location.buffer();
-    if (!buffer)
-        return false;
-
-    SLANG_ASSERT(buffer.getId() < bufferEntries.size());
-    auto info = std::get_if<ExpansionInfo>(&bufferEntries[buffer.getId()]);
+    auto info = getExpansionInfo(location.buffer());
     return info && info->isMacroArg;
 }
 
-template<IsLock TLock>
-SourceRange SourceManager::getExpansionRangeImpl(SourceLocation location, TLock&) const {
+SourceRange SourceManager::getExpansionRangeImpl(SourceLocation location) const {
     auto buffer = location.buffer();
     if (!buffer)
         return SourceRange();
 
-    SLANG_ASSERT(buffer.getId() < bufferEntries.size());
-    return std::get<ExpansionInfo>(bufferEntries[buffer.getId()]).expansionRange;
+    auto info = getExpansionInfo(buffer);
+    SLANG_ASSERT(info);
+    return info->expansionRange;
 }
 
-template<IsLock TLock>
-SourceLocation SourceManager::getOriginalLocImpl(SourceLocation location, TLock&) const {
+SourceLocation SourceManager::getOriginalLocImpl(SourceLocation location) const {
     auto buffer = location.buffer();
     if (!buffer)
         return SourceLocation();
 
-    SLANG_ASSERT(buffer.getId() < bufferEntries.size());
-    return std::get<ExpansionInfo>(bufferEntries[buffer.getId()]).originalLoc + location.offset();
+    auto info = getExpansionInfo(buffer);
+    SLANG_ASSERT(info);
+    return info->originalLoc + location.offset();
 }
 
 void SourceManager::computeLineOffsets(const SmallVector<char>& buffer,
@@ -654,28 +613,34 @@ void SourceManager::computeLineOffsets(const SmallVector<char>& buffer,
 const SourceManager::LineDirectiveInfo* SourceManager::FileInfo::getPreviousLineDirective(
     size_t rawLineNumber) const {
 
-    if (lineDirectives.empty())
+    auto directives = lineDirectives.load(std::memory_order_acquire);
+    if (!directives)
         return nullptr;
 
-    auto it = std::ranges::lower_bound(lineDirectives, rawLineNumber, {},
-                                       &LineDirectiveInfo::lineInFile);
-
-    // lower_bound will give us an iterator to the first directive after the command
-    // let's instead get a pointer to the one right before it
-    if (it == lineDirectives.begin()) {
-        if (it->lineInFile == rawLineNumber)
-            return &(*it);
+    uint32_t count = directives->size();
+    if (count == 0)
         return nullptr;
+
+    // Find the first directive at or after the given line number.
+    uint32_t first = 0;
+    uint32_t last = count;
+    while (first < last) {
+        uint32_t mid = first + (last - first) / 2;
+        if (directives->get(mid)->lineInFile < rawLineNumber)
+            first = mid + 1;
+        else
+            last = mid;
     }
-    else {
-        if (it == lineDirectives.end()) {
-            // Check to see whether the actual last directive is before the
-            // given line number
-            if (lineDirectives.back().lineInFile >= rawLineNumber)
-                return nullptr;
-        }
-        return &*(it - 1);
+
+    // We want the one right before it, unless the first directive
+    // is on the line itself.
+    if (first == 0) {
+        auto directive = directives->get(0);
+        if (directive->lineInFile == rawLineNumber)
+            return directive;
+        return nullptr;
     }
+    return directives->get(first - 1);
 }
 
 } // namespace slang
@@ -177,6 +177,64 @@ TEST_CASE("Driver file preprocess -- obfuscation") {
                            "\n"));
 }
 
+TEST_CASE("Driver file preprocess -- independent units in parallel") {
+    auto preprocess = [](const char* threads) {
+        auto guard = OS::captureOutput();
+
+        Driver driver;
+        driver.addStandardArgs();
+
+        auto file1 = findTestDir() + "test.sv";
+        auto file2 = findTestDir() + "test3.sv";
+        auto file3 = findTestDir() + "test4.sv";
+        auto file4 = findTestDir() + "test5.sv";
+        const char* argv[] = {"testfoo",     file1.c_str(), file2.c_str(), file3.c_str(),
+                              file4.c_str(), "--threads",   threads};
+        CHECK(driver.parseCommandLine(7, argv));
+        CHECK(driver.processOptions());
+        CHECK(driver.runPreprocessor(false, false, false));
+        return OS::capturedStdout;
+    };
+
+    auto serial = preprocess("1");
+    auto parallel = preprocess("4");
+    CHECK(serial == parallel);
+
+    auto m = parallel.find("module m;");
+    auto baz = parallel.find("module baz;");
+    auto k = parallel.find("module k;");
+    CHECK(m < baz);
+    CHECK(baz < k);
+}
+
+TEST_CASE("Driver report macros -- undef across independent units") {
+    auto reportMacros = [](const char* threads) {
+        auto guard = OS::captureOutput();
+
+        Driver driver;
+        driver.addStandardArgs();
+
+        auto file1 = findTestDir() + "test.sv";
+        auto file2 = findTestDir() + "test3.sv";
+        auto file3 = findTestDir() + "undef.sv";
+        auto file4 = findTestDir() + "test5.sv";
+        const char* argv[] = {"testfoo",     file1.c_str(), file2.c_str(), file3.c_str(),
+                              file4.c_str(), "--threads",   threads};
+        CHECK(driver.parseCommandLine(7, argv));
+        CHECK(driver.processOptions());
+        driver.reportMacros();
+        return OS::capturedStdout;
+    };
+
+    auto serial = reportMacros("1");
+    auto parallel = reportMacros("4");
+    CHECK(serial == parallel);
+
+    CHECK(parallel.find("ID(x)") == std::string::npos);
+    CHECK(parallel.find("SOME_DEF") != std::string::npos);
+    CHECK(parallel.find("UNDEF_TEST 1") != std::string::npos);
+}
+
 TEST_CASE("Driver file preprocess with error") {
     auto guard = OS::captureOutput();
 
@@ -491,6 +549,26 @@ TEST_CASE("Driver suppress warnings by path") {
     CHECK(driver.reportCompilation(*compilation, false));
     CHECK(stdoutContains("Build succeeded"));
     CHECK(stdoutContains("0 errors, 0 warnings"));
+    CHECK(stdoutContains("suppressed by filter"));
+}
+
+TEST_CASE("Driver no filter note without suppression") {
+    auto guard = OS::captureOutput();
+
+    Driver driver;
+    driver.addStandardArgs();
+
+    // With every warning enabled and nothing suppressed, the filter has
+    // nothing to drop and the note shouldn't be printed.
+    auto args = fmt::format("testfoo \"{0}test5.sv\" -Weverything", findTestDir());
+    CHECK(driver.parseCommandLine(args));
+    CHECK(driver.processOptions());
+    CHECK(driver.parseAllSources());
+
+    auto compilation = driver.createCompilation();
+    CHECK(driver.reportCompilation(*compilation, false));
+    CHECK(compilation->getNumFilteredDiagnostics() == 0);
+    CHECK(!stdoutContains("suppressed by filter"));
 }
 
 TEST_CASE("Driver suppress macro warnings by path") {
@@ -3,6 +3,7 @@
 
 #include "Test.h"
 #include <fstream>
+#include <thread>
 
 #include "slang/text/Glob.h"
 #include "slang/text/SourceManager.h"
@@ -93,6 +94,82 @@ TEST_CASE("Read header (dev/null)") {
     }
 }
 
+TEST_CASE("Concurrent location queries") {
+    SourceManager manager;
+    auto first = manager.assignText("line1\nline2\nline3\n");
+    auto second = manager.assignText("a.sv", "line1\nline2\nline3\n");
+    SourceLocation loc(first.id, 6);
+    SourceLocation loc2(second.id, 12);
+
+    // Readers run entirely concurrently with buffers and expansions being added,
+    // so they can only record failures and report them afterward.
+    std::atomic<bool> done = false;
+    std::atomic<int> failures = 0;
+    auto reader = [&] {
+        while (!done.load()) {
+            auto buffers = manager.getAllBuffers();
+            auto last = SourceLocation(buffers.back(), 0);
+            if (manager.isMacroLoc(last)) {
+                auto expanded = manager.getFullyExpandedLoc(last);
+                if (expanded != loc || manager.getLineNumber(last) != 2 ||
+                    manager.getMacroName(last) != "FOO"sv) {
+                    failures++;
+                }
+            }
+            else if (manager.getFullPath(last.buffer()).empty()) {
+                failures++;
+            }
+
+            auto name = manager.getFileName(loc2);
+            if (manager.getLineNumber(loc) != 2 || (name != "a.sv"sv && name != "b.sv"sv))
+                failures++;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++)
+        threads.emplace_back(reader);
+
+    for (int i = 0; i < 5000; i++) {
+        if (i % 100 == 0)
+            manager.assignText("// " + std::to_string(i) + "\n");
+        else
+            manager.createExpansionLoc(loc, SourceRange(loc, loc + 1), "FOO"sv);
+
+        if (i == 2500)
+            manager.addLineDirective(SourceLocation(second.id, 6), 10, "b.sv", 0);
+    }
+
+    done = true;
+    for (auto& thread : threads)
+        thread.join();
+
+    CHECK(failures == 0);
+    CHECK(manager.getAllBuffers().size() == 5002);
+    CHECK(manager.getFileName(loc2) == "b.sv");
+    CHECK(manager.getLineNumber(loc2) == 10);
+}
+
+TEST_CASE("Many line directives") {
+    SourceManager manager;
+    std::string text;
+    for (int i = 0; i < 200; i++)
+        text += "line\n";
+
+    // Enough directives to spill over several chunks of the directive table.
+    auto buffer = manager.assignText(text);
+    for (size_t i = 0; i < 200; i += 2) {
+        manager.addLineDirective(SourceLocation(buffer.id, i * 5), 1,
+                                 "f" + std::to_string(i) + ".sv", 0);
+    }
+
+    for (size_t i = 1; i < 200; i += 2) {
+        SourceLocation loc(buffer.id, i * 5);
+        CHECK(manager.getFileName(loc) == "f" + std::to_string(i - 1) + ".sv");
+        CHECK(manager.getLineNumber(loc) == 1);
+    }
+}
+
 static void globAndCheck(const fs::path& basePath, std::string_view pattern, GlobMode mode,
                          GlobRank expectedRank, std::error_code expectedEc,
                          std::initializer_list<const char*> expected) {
@@ -216,6 +216,41 @@ endfunction
     NO_SESSION_ERRORS;
 }
 
+TEST_CASE("Eval recursive function locals") {
+    ScriptSession session;
+    session.eval(R"(
+function automatic int fib(int n);
+    int a, b;
+    if (n < 2)
+        return n;
+    begin
+        int t = n - 1;
+        a = fib(t);
+    end
+    begin
+        int t = n - 2;
+        b = fib(t);
+    end
+    return a + b;
+endfunction
+)");
+
+    session.eval(R"(
+function automatic int sum(int n);
+    int total = 0;
+    for (int i = 0; i < n; i++) begin
+        int sq = i * i;
+        total += sq;
+    end
+    return total;
+endfunction
+)");
+
+    CHECK(session.eval("fib(15)").integer() == 610);
+    CHECK(session.eval("sum(100)").integer() == 328350);
+    NO_SESSION_ERRORS;
+}
+
 TEST_CASE("Integer operators") {
     ScriptSession session;
 
@@ -8,6 +8,7 @@
 #include "slang/ast/symbols/InstanceSymbols.h"
 #include "slang/ast/symbols/MemberSymbols.h"
 #include "slang/ast/symbols/ParameterSymbols.h"
+#include "slang/parsing/Parser.h"
 #include "slang/text/SourceManager.h"
 
 TEST_CASE("Finding top level") {
@@ -1908,3 +1909,205 @@ endmodule
     compilation.addSyntaxTree(tree);
     NO_COMPILATION_ERRORS;
 }
+
+TEST_CASE("Incremental elaboration of changed trees") {
+    auto leaf = SyntaxTree::fromText(R"(
+module leaf;
+    int i = foo;
+endmodule
+)");
+    auto top = SyntaxTree::fromText(R"(
+module top;
+    leaf l();
+endmodule
+)");
+    auto other = SyntaxTree::fromText(R"(
+module other;
+    int j = bar;
+endmodule
+)");
+
+    auto elabWithChange = [&](std::shared_ptr<SyntaxTree> changed) {
+        Compilation compilation;
+        compilation.addSyntaxTree(leaf);
+        compilation.addSyntaxTree(top);
+        compilation.addSyntaxTree(other);
+
+        std::shared_ptr<SyntaxTree> changedTrees[] = {changed};
+        return compilation.elaborateIncremental(changedTrees);
+    };
+
+    // Changing leaf affects top as well, since it instantiates leaf,
+    // but the diagnostic in the unrelated module isn't returned.
+    auto diags = elabWithChange(leaf);
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::UndeclaredIdentifier);
+    CHECK(std::get<std::string>(diags[0].args[0]) == "foo");
+
+    // Changing top re-checks the leaf it instantiates, since parameters and
+    // port connections flow down into it.
+    diags = elabWithChange(top);
+    REQUIRE(diags.size() == 1);
+    CHECK(std::get<std::string>(diags[0].args[0]) == "foo");
+
+    diags = elabWithChange(other);
+    REQUIRE(diags.size() == 1);
+    CHECK(std::get<std::string>(diags[0].args[0]) == "bar");
+}
+
+TEST_CASE("Incremental elaboration covers children and removed definitions") {
+    auto child = SyntaxTree::fromText(R"(
+module child #(parameter int W = 1);
+    if (W > 4) begin : g
+        int i = foo;
+    end
+endmodule
+)");
+    auto oldMid = SyntaxTree::fromText(R"(
+module mid;
+    child #(2) c();
+endmodule
+)");
+    auto newMid = SyntaxTree::fromText(R"(
+module mid;
+    child #(8) c();
+endmodule
+)");
+    auto renamedMid = SyntaxTree::fromText(R"(
+module mid2;
+endmodule
+)");
+    auto top = SyntaxTree::fromText(R"(
+module top;
+    mid m();
+endmodule
+)");
+
+    // The parameter passed down from the changed module makes the child
+    // body report a new error, even though the child itself didn't change.
+    {
+        Compilation compilation;
+        compilation.addSyntaxTree(child);
+        compilation.addSyntaxTree(newMid);
+        compilation.addSyntaxTree(top);
+
+        std::shared_ptr<SyntaxTree> changed[] = {newMid};
+        std::shared_ptr<SyntaxTree> previous[] = {oldMid};
+        auto diags = compilation.elaborateIncremental(changed, previous);
+        REQUIRE(diags.size() == 1);
+        CHECK(diags[0].code == diag::UndeclaredIdentifier);
+    }
+
+    // Renaming the module breaks top, which only referred to the old name.
+    {
+        Compilation compilation;
+        compilation.addSyntaxTree(child);
+        compilation.addSyntaxTree(renamedMid);
+        compilation.addSyntaxTree(top);
+
+        std::shared_ptr<SyntaxTree> changed[] = {renamedMid};
+        std::shared_ptr<SyntaxTree> previous[] = {oldMid};
+        auto diags = compilation.elaborateIncremental(changed, previous);
+        REQUIRE(diags.size() == 1);
+        CHECK(diags[0].code == diag::UnknownModule);
+    }
+}
+
+TEST_CASE("Incremental elaboration matches full elaboration diagnostics") {
+    auto leaf = SyntaxTree::fromText(R"(
+class C;
+endclass
+
+function void C::missing();
+endfunction
+
+module leaf;
+    int i = foo;
+endmodule
+)");
+    auto top = SyntaxTree::fromText(R"(
+module top;
+    leaf l();
+endmodule
+)");
+    auto other = SyntaxTree::fromText(R"(
+module other;
+    int j = bar;
+endmodule
+)");
+
+    auto makeCompilation = [&](Compilation& compilation) {
+        compilation.addSyntaxTree(leaf);
+        compilation.addSyntaxTree(top);
+        compilation.addSyntaxTree(other);
+    };
+
+    auto getKeys = [](const Diagnostics& diags) {
+        std::vector<std::pair<SourceLocation, DiagCode>> keys;
+        for (auto& diag : diags)
+            keys.emplace_back(diag.location, diag.code);
+        std::ranges::sort(keys);
+        return keys;
+    };
+
+    Compilation full;
+    makeCompilation(full);
+    Diagnostics expected;
+    for (auto& diag : full.getSemanticDiagnostics()) {
+        if (diag.location.buffer() != other->root().getFirstToken().location().buffer())
+            expected.push_back(diag);
+    }
+
+    // The out-of-block method check only runs after the hierarchy has been
+    // visited, so it has to be part of the incremental pass too.
+    Compilation incremental;
+    makeCompilation(incremental);
+    std::shared_ptr<SyntaxTree> changed[] = {leaf};
+    auto diags = incremental.elaborateIncremental(changed);
+
+    CHECK(getKeys(diags) == getKeys(expected));
+    CHECK(std::ranges::any_of(diags, [](auto& d) { return d.code == diag::NoDeclInClass; }));
+}
+
+TEST_CASE("Deferred library module bodies") {
+    Bag options;
+    ParserOptions parserOptions;
+    parserOptions.deferModuleBodies = true;
+    options.set(parserOptions);
+
+    auto lib = SyntaxTree::fromText(R"(
+module leaf #(parameter int W = 1)(input logic [W-1:0] a);
+    localparam int D = W * 2;
+    logic [D-1:0] b;
+    assign b = {a, a};
+endmodule
+
+module unused;
+    int i = 1;
+endmodule
+)",
+                                    options);
+    lib->isLibraryUnit = true;
+
+    auto tree = SyntaxTree::fromText(R"(
+module top;
+    logic [3:0] a;
+    leaf #(.W(4)) c(.a);
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(lib);
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& c = compilation.getRoot().lookupName<InstanceSymbol>("top.c");
+    CHECK(!c.getDefinition().hasDeferredBody());
+    CHECK(c.body.find<ParameterSymbol>("D").getValue().integer() == 8);
+
+    // The unused definition never gets its body parsed.
+    auto defs = compilation.getDefinitions();
+    REQUIRE(defs.size() == 3);
+    CHECK(defs[2]->name == "unused");
+    CHECK(defs[2]->as<DefinitionSymbol>().hasDeferredBody());
+}
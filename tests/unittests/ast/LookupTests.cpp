@@ -5,6 +5,7 @@
 
 #include "slang/ast/Compilation.h"
 #include "slang/ast/EvalContext.h"
+#include "slang/ast/ScriptSession.h"
 #include "slang/ast/expressions/AssignmentExpressions.h"
 #include "slang/ast/expressions/MiscExpressions.h"
 #include "slang/ast/symbols/BlockSymbols.h"
@@ -2174,3 +2175,124 @@ endmodule
     CHECK(diags[4].code == diag::UndeclaredIdentifier);
     CHECK(diags[5].code == diag::ImplicitNamedPortNotFound);
 }
+
+TEST_CASE("Repeated wildcard import lookups respect import location") {
+    auto tree = SyntaxTree::fromText(R"(
+package p;
+    int x = 1;
+endpackage
+
+package q;
+    int y = 2;
+    int x = 3;
+endpackage
+
+module m;
+    import p::*;
+    int a = x;
+    int b = x;
+    int c = y;
+    int d = y;
+    import q::*;
+    int e = y;
+    int f = y;
+    int g = z;
+    int h = z;
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    // The remaining diagnostics are static initialization order warnings.
+    Diagnostics errors;
+    for (auto& diag : compilation.getAllDiagnostics()) {
+        if (diag.isError())
+            errors.push_back(diag);
+    }
+
+    REQUIRE(errors.size() == 4);
+    CHECK(errors[0].code == diag::UndeclaredIdentifier);
+    CHECK(errors[1].code == diag::UndeclaredIdentifier);
+    CHECK(errors[2].code == diag::UndeclaredIdentifier);
+    CHECK(errors[3].code == diag::UndeclaredIdentifier);
+
+    auto& m = compilation.getRoot().lookupName<InstanceSymbol>("m").body;
+    auto& e = m.lookupName<VariableSymbol>("e");
+    auto& y = compilation.getPackage("q")->lookupName<VariableSymbol>("y");
+    CHECK(&e.getInitializer()->as<NamedValueExpression>().symbol == &y);
+}
+
+TEST_CASE("Repeated upward hierarchical lookups") {
+    auto tree = SyntaxTree::fromText(R"(
+module leaf;
+    int a, b, c;
+    assign a = mid.x + mid.x;
+    assign b = top.m1.x + top.m2.x;
+    assign c = m2.x;
+endmodule
+
+module mid;
+    int x;
+    leaf l();
+endmodule
+
+module top;
+    mid m1();
+    mid m2();
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& leaf = compilation.getRoot().lookupName<InstanceSymbol>("top.m2.l").body;
+    auto candidates = Lookup::getUpwardCandidates(leaf, "mid");
+    REQUIRE(candidates.size() == 1);
+    CHECK(candidates[0] == compilation.getRoot().lookupName("top.m2"));
+    CHECK(Lookup::getUpwardCandidates(leaf, "mid").data() == candidates.data());
+}
+
+TEST_CASE("Typo correction picks closest earliest member") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    int counter_valve;
+    int counter_value;
+    int counter_values;
+    int abc;
+    initial begin
+        counter_valxe = 1;
+        counter_valuess = 1;
+        xyz = 1;
+        ab = 1;
+    end
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 4);
+    CHECK(diags[0].code == diag::TypoIdentifier);
+    CHECK(diags[1].code == diag::TypoIdentifier);
+    CHECK(diags[2].code == diag::UndeclaredIdentifier);
+    CHECK(diags[3].code == diag::UndeclaredIdentifier);
+
+    auto result = report(diags);
+    CHECK(result.find("did you mean 'counter_valve'") != std::string::npos);
+    CHECK(result.find("did you mean 'counter_values'") != std::string::npos);
+}
+
+TEST_CASE("Typo correction sees members added after the first correction") {
+    ScriptSession session;
+    session.eval("int abcdef;");
+    session.eval("abcdeg");
+    session.eval("int uvwxyz;");
+    session.eval("uvwxya");
+
+    auto result = report(session.getDiagnostics());
+    CHECK(result.find("did you mean 'abcdef'") != std::string::npos);
+    CHECK(result.find("did you mean 'uvwxyz'") != std::string::npos);
+}
@@ -4,9 +4,11 @@
 #include "Test.h"
 #include <fmt/format.h>
 
+#include "slang/ast/Expression.h"
 #include "slang/ast/symbols/CompilationUnitSymbols.h"
 #include "slang/ast/symbols/InstanceSymbols.h"
 #include "slang/ast/symbols/ParameterSymbols.h"
+#include "slang/ast/symbols/SpecifySymbols.h"
 #include "slang/ast/types/Type.h"
 
 SVInt testParameter(const std::string& text, uint32_t index = 0) {
@@ -1266,3 +1268,72 @@ endmodule
         CHECK(p.getValue().integer() == i + 1);
     }
 }
+
+TEST_CASE("Concurrent evaluation of self-contained parameters") {
+    std::string text = "module m;\n";
+    for (int i = 0; i < 100; i++)
+        text += fmt::format("    localparam int p{0} = {0} * 3 + (1:2:3);\n", i);
+
+    text += "    localparam int q = p1 + p2;\n    specify\n";
+    for (int i = 0; i < 100; i++)
+        text += fmt::format("        specparam s{0} = {0}.5 + 1;\n", i);
+    text += "    endspecify\nendmodule\n";
+
+    auto tree = SyntaxTree::fromText(text);
+
+    CompilationOptions options;
+    options.numThreads = 4;
+
+    Compilation compilation(options);
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& m = compilation.getRoot().lookupName<InstanceSymbol>("m").body;
+    for (int i = 0; i < 100; i++) {
+        auto& p = m.lookupName<ParameterSymbol>(fmt::format("p{}", i));
+        CHECK(p.getValue().integer() == i * 3 + 2);
+
+        auto& init = *p.getInitializer();
+        REQUIRE(init.constant);
+        CHECK(*init.constant == p.getValue());
+    }
+
+    CHECK(m.lookupName<ParameterSymbol>("q").getValue().integer() == 13);
+
+    auto& specify = *m.membersOfType<SpecifyBlockSymbol>().begin();
+    for (int i = 0; i < 100; i++) {
+        auto& s = specify.lookupName<SpecparamSymbol>(fmt::format("s{}", i));
+        CHECK(s.getValue().real() == i + 1.5);
+    }
+}
+
+TEST_CASE("Identical parameter values share interned constants") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    localparam int a = 5;
+    localparam int b = 2 + 3;
+    localparam bit [3:0] c = 5;
+    localparam real d = 0.0;
+    localparam real e = -0.0;
+    localparam real f = 1.0 - 1.0;
+    localparam string g = "hello";
+    localparam string h = "hello";
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& m = compilation.getRoot().lookupName<InstanceSymbol>("m").body;
+    auto getValue = [&](std::string_view name) {
+        return &m.lookupName<ParameterSymbol>(name).getValue();
+    };
+
+    CHECK(getValue("a") == getValue("b"));
+    CHECK(getValue("a") != getValue("c"));
+    CHECK(getValue("d") != getValue("e"));
+    CHECK(getValue("d") == getValue("f"));
+    CHECK(getValue("g") == getValue("h"));
+    CHECK(compilation.getInternedConstantBytesSaved() > 0);
+}
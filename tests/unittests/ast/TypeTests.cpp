@@ -2214,3 +2214,81 @@ logic [-2147483648:-2147483649] a;
     CHECK(diags[1].code == diag::SignedIntegerOverflow);
     CHECK(diags[2].code == diag::SignedIntegerOverflow);
 }
+
+TEST_CASE("Array types are interned") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    logic [7:0][3:0] a, b;
+    logic [7:0][3:0] c;
+    int d[16];
+endmodule
+
+module top;
+    m m1();
+    m m2();
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& root = compilation.getRoot();
+    auto getType = [&](std::string_view name) {
+        return &root.lookupName<VariableSymbol>(name).getType();
+    };
+
+    // Types declared by the same syntax are shared, including across instances.
+    CHECK(getType("top.m1.a") == getType("top.m1.b"));
+    CHECK(getType("top.m1.a") == getType("top.m2.a"));
+    CHECK(getType("top.m1.d") == getType("top.m2.d"));
+
+    // Types from different declarations keep their own syntax.
+    auto a = getType("top.m1.a");
+    auto c = getType("top.m1.c");
+    CHECK(a != c);
+    CHECK(a->isMatching(*c));
+    REQUIRE(a->getSyntax());
+    REQUIRE(c->getSyntax());
+    CHECK(a->getSyntax() != c->getSyntax());
+    CHECK(getType("top.m1.d")->getSyntax());
+
+    CHECK(&compilation.getType(8, IntegralFlags::FourState) ==
+          &compilation.getType(8, IntegralFlags::FourState));
+}
+
+TEST_CASE("Type relation cache") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    typedef struct packed { logic [3:0] a; logic b; } s_t;
+    s_t s1, s2;
+    logic [4:0] v;
+    real r;
+
+    initial begin
+        s1 = s2;
+        s1 = s2;
+        v = s1;
+        v = s2;
+        r = real'(v);
+    end
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    auto& stats = compilation.getTypeRelationCacheStats();
+    CHECK(stats.hits > 0);
+    CHECK(stats.misses > 0);
+
+    auto& m = compilation.getRoot().lookupName<InstanceSymbol>("m").body;
+    auto& v = m.lookupName<VariableSymbol>("v").getType();
+    auto& r = m.lookupName<VariableSymbol>("r").getType();
+    auto hits = stats.hits;
+    CHECK(compilation.checkTypeRelation(r, v, TypeRelation::AssignmentCompatible));
+    CHECK(!compilation.checkTypeRelation(r, v, TypeRelation::Equivalent));
+    CHECK(compilation.checkTypeRelation(r, v, TypeRelation::AssignmentCompatible));
+    CHECK(stats.hits > hits);
+}
@@ -0,0 +1,2 @@
+`undef ID
+`define UNDEF_TEST 1
@@ -3,7 +3,10 @@
 
 #include "Test.h"
 
+#include <sstream>
+
 #include "slang/diagnostics/DiagnosticClient.h"
+#include "slang/diagnostics/JsonDiagnosticClient.h"
 #include "slang/diagnostics/TextDiagnosticClient.h"
 #include "slang/text/SourceManager.h"
 
@@ -576,3 +579,140 @@ source:3:33: error: use of undeclared identifier 'a'
                                         ^
 )");
 }
+
+TEST_CASE("Diagnostics sort with multiple threads") {
+    SourceManager sm;
+    auto buf1 = sm.assignText("file1.sv", std::string(1024, ' '));
+    auto buf2 = sm.assignText("file2.sv", std::string(1024, ' '));
+
+    // Enough diagnostics to cross the threshold for sorting in parallel,
+    // interleaved across buffers and with duplicate locations.
+    Diagnostics diags;
+    for (size_t i = 0; i < 40000; i++) {
+        auto& buf = (i % 3) ? buf1 : buf2;
+        auto code = ((i / 1000) % 2) ? diag::ExpectedIdentifier : diag::ExpectedExpression;
+        diags.add(code, SourceLocation(buf.id, 1000 - (i % 1000)));
+    }
+
+    Diagnostics serial = diags;
+    serial.sort(sm);
+    diags.sort(sm, 4);
+
+    REQUIRE(diags.size() == serial.size());
+    for (size_t i = 0; i < diags.size(); i++) {
+        CHECK(diags[i].location == serial[i].location);
+        CHECK(diags[i].code == serial[i].code);
+    }
+
+    CHECK(diags[0].location == SourceLocation(buf1.id, 1));
+    CHECK(diags[0].code == diag::ExpectedExpression);
+    CHECK(diags.back().location == SourceLocation(buf2.id, 1000));
+}
+
+TEST_CASE("Diagnostics streamed to output sink") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    int i = a + b + c;
+    int j = d;
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    DiagnosticEngine engine(tree->sourceManager());
+    auto buffered = std::make_shared<TextDiagnosticClient>();
+    auto streamed = std::make_shared<TextDiagnosticClient>();
+    engine.addClient(buffered);
+    engine.addClient(streamed);
+
+    std::vector<std::string> chunks;
+    streamed->setOutputSink([&](std::string_view text) { chunks.emplace_back(text); }, 0);
+
+    auto& diags = compilation.getAllDiagnostics();
+    for (auto& diag : diags)
+        engine.issue(diag);
+    streamed->flush();
+
+    // Each diagnostic should have been handed off as soon as it was formatted.
+    CHECK(chunks.size() == diags.size());
+    CHECK(streamed->getString().empty());
+
+    std::string combined;
+    for (auto& chunk : chunks)
+        combined += chunk;
+
+    CHECK("\n"s + combined == R"(
+source:3:13: error: use of undeclared identifier 'a'
+    int i = a + b + c;
+            ^
+source:3:17: error: use of undeclared identifier 'b'
+    int i = a + b + c;
+                ^
+source:3:21: error: use of undeclared identifier 'c'
+    int i = a + b + c;
+                    ^
+source:4:13: error: use of undeclared identifier 'd'
+    int j = d;
+            ^
+)");
+    CHECK(combined == buffered->getString());
+}
+
+TEST_CASE("JSON Lines diagnostic client") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    int i = a;
+    int j = b;
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    DiagnosticEngine engine(tree->sourceManager());
+    auto client = std::make_shared<JsonDiagnosticClient>();
+    engine.addClient(client);
+    for (auto& diag : compilation.getAllDiagnostics())
+        engine.issue(diag);
+
+    std::vector<std::string> lines;
+    std::istringstream stream(client->getString());
+    for (std::string line; std::getline(stream, line);)
+        lines.push_back(line);
+
+    REQUIRE(lines.size() == 3);
+    CHECK(lines[0] == R"({"file":0,"name":"source"})");
+    CHECK(lines[1].starts_with(
+        R"({"code":"UndeclaredIdentifier","severity":"error","file":0,"line":3,"column":13,)"
+        R"("message":"use of undeclared identifier 'a'","args":["a"])"));
+    CHECK(lines[2].starts_with(
+        R"({"code":"UndeclaredIdentifier","severity":"error","file":0,"line":4,"column":13,)"));
+}
+
+TEST_CASE("Diagnostic filter drops suppressed diagnostics early") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    logic [31:0] i;
+    logic [1:0] a, b;
+    assign a = i;
+    assign b = i;
+    initial c = 1;
+endmodule
+)");
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+
+    DiagnosticEngine engine(tree->sourceManager());
+    engine.setSeverity(diag::WidthTruncate, DiagnosticSeverity::Ignored);
+    compilation.setDiagnosticFilter([&](DiagCode code, SourceLocation location) {
+        return engine.isSuppressed(code, location);
+    });
+
+    // Errors are never filtered, even if the engine would ignore them.
+    auto& diags = compilation.getAllDiagnostics();
+    REQUIRE(diags.size() == 1);
+    CHECK(diags[0].code == diag::UndeclaredIdentifier);
+    CHECK(compilation.getNumFilteredDiagnostics() == 2);
+}
@@ -1263,3 +1263,33 @@ TEST_CASE("Hex escape corner case") {
     CHECK(diagnostics[0].code == diag::InvalidHexEscapeCode);
     CHECK(diagnostics[1].code == diag::ExpectedClosingQuote);
 }
+
+TEST_CASE("Compact token storage") {
+    BumpAllocator tokenAlloc;
+    Diagnostics localDiags;
+    auto buffer = getSourceManager().assignText("+-*begin");
+    Lexer lexer(buffer, tokenAlloc, localDiags);
+
+    // Tokens with fixed text and no trivia only store their location.
+    SmallVector<Token> tokens;
+    size_t before = tokenAlloc.getBytesUsed();
+    for (int i = 0; i < 4; i++)
+        tokens.push_back(lexer.lex());
+    CHECK(tokenAlloc.getBytesUsed() - before == 4 * sizeof(SourceLocation));
+
+    CHECK(tokens[0].rawText() == "+");
+    CHECK(tokens[2].location().offset() == 2);
+    CHECK(tokens[3].kind == TokenKind::BeginKeyword);
+    CHECK(tokens[3].range().end().offset() == 8);
+
+    // Kind-specific data must still be found behind a stored text pointer.
+    Token num = lexToken("123");
+    Token cloned = num.deepClone(alloc).withRawText(alloc, "");
+    CHECK(cloned.rawText().empty());
+    CHECK(cloned.intValue() == 123);
+
+    Token str = lexToken("\"a\\tb\"");
+    Token moved = str.withLocation(alloc, SourceLocation::NoLocation);
+    CHECK(moved.rawText() == "\"a\\tb\"");
+    CHECK(moved.valueText() == "a\tb");
+}
@@ -5,6 +5,7 @@
 
 #include "slang/parsing/Parser.h"
 #include "slang/parsing/Preprocessor.h"
+#include "slang/syntax/SyntaxPrinter.h"
 
 TEST_CASE("Simple module") {
     auto& text = "module foo(); endmodule";
@@ -1489,3 +1490,53 @@ endmodule
     REQUIRE(diagnostics.size() == 1);
     CHECK(diagnostics[0].code == diag::UnexpectedEndDelim);
 }
+
+TEST_CASE("Deferred module bodies") {
+    auto& text = R"(
+module m #(parameter int P = 1)(input logic a);
+    foo #(2) f1(.a(a));
+    bar b1(a);
+    baz b2[3:0](a);
+endmodule
+
+`define FOO 1
+module n;
+    int i = `FOO;
+endmodule
+
+interface I;
+    modport mp();
+endinterface
+)";
+
+    Bag options;
+    ParserOptions parserOptions;
+    parserOptions.deferModuleBodies = true;
+    options.set(parserOptions);
+
+    auto tree = SyntaxTree::fromText(text, options);
+    CHECK(tree->diagnostics().empty());
+    CHECK(SyntaxPrinter::printFile(*tree) == text);
+
+    auto& meta = tree->getMetadata();
+    auto& members = tree->root().as<CompilationUnitSyntax>().members;
+    REQUIRE(members.size() == 3);
+
+    auto& m = members[0]->as<ModuleDeclarationSyntax>();
+    CHECK(m.members.empty());
+    CHECK(meta.deferredBodies.contains(&m));
+    CHECK(meta.globalInstances.contains("foo"));
+    CHECK(meta.globalInstances.contains("bar"));
+    CHECK(meta.globalInstances.contains("baz"));
+
+    // Bodies that use macros are always parsed up front.
+    CHECK(!meta.deferredBodies.contains(&members[1]->as<ModuleDeclarationSyntax>()));
+    CHECK(meta.deferredBodies.contains(&members[2]->as<ModuleDeclarationSyntax>()));
+
+    Diagnostics diags;
+    auto full = tree->parseDeferredBody(m, alloc, diags);
+    REQUIRE(full);
+    CHECK(diags.empty());
+    CHECK(full->members.size() == 3);
+    CHECK("\n" + full->toString() == SyntaxPrinter().setIncludeSkipped(true).print(m).str());
+}
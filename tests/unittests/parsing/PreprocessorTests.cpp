@@ -2682,3 +2682,55 @@ endmodule
     REQUIRE(diagnostics.size() == 1);
     CHECK(diagnostics[0].code == diag::ProtectedEnvelope);
 }
+
+TEST_CASE("Repeated macro usages reuse expansions") {
+    auto& text = R"(
+`define ONE 1
+`define ADD(a, b) a + b
+`define STR(a) `"a`"
+int x = `ADD(`ONE, 2);
+int y = `ADD(`ONE, 2);
+int w = `ADD(`ONE, 2);
+string s = `STR(foo);
+string t = `STR(foo);
+`undef ONE
+`define ONE 3
+int z = `ADD(`ONE, 2);
+)";
+
+    diagnostics.clear();
+    auto& sm = getSourceManager();
+    Preprocessor preprocessor(sm, alloc, diagnostics);
+    preprocessor.pushSource(text);
+
+    std::string result;
+    SmallVector<Token> twos;
+    while (true) {
+        Token token = preprocessor.next();
+        result += token.toString();
+        if (token.kind == TokenKind::IntegerLiteral && token.valueText() == "2")
+            twos.push_back(token);
+        if (token.kind == TokenKind::EndOfFile)
+            break;
+    }
+
+    for (auto expected : {"int x = 1 + 2;", "int y = 1 + 2;", "int w = 1 + 2;",
+                          "string s = \"foo\";", "string t = \"foo\";", "int z = 3 + 2;"}) {
+        CHECK(result.find(expected) != std::string::npos);
+    }
+    CHECK_DIAGNOSTICS_EMPTY;
+
+    // Expansions are cached the second time a usage is seen, so only the
+    // third `ADD usage before the redefinition gets to reuse one.
+    CHECK(preprocessor.getNumReusedExpansions() == 1);
+
+    // Each usage must point back at its own arguments and expansion site.
+    REQUIRE(twos.size() == 4);
+    auto line = [&](SourceLocation loc) { return sm.getLineNumber(loc); };
+    auto firstLine = line(sm.getFullyOriginalLoc(twos[0].location()));
+    CHECK(line(sm.getFullyOriginalLoc(twos[1].location())) == firstLine + 1);
+    CHECK(line(sm.getFullyExpandedLoc(twos[1].location())) == firstLine + 1);
+    CHECK(line(sm.getFullyOriginalLoc(twos[2].location())) == firstLine + 2);
+    CHECK(line(sm.getFullyExpandedLoc(twos[2].location())) == firstLine + 2);
+    CHECK(line(sm.getFullyOriginalLoc(twos[3].location())) == firstLine + 7);
+}
@@ -3,11 +3,13 @@
 
 #include "Test.h"
 #include <fmt/core.h>
+#include <thread>
 
 #include "slang/ast/ASTVisitor.h"
 #include "slang/parsing/ParserMetadata.h"
 #include "slang/syntax/SyntaxPrinter.h"
 #include "slang/syntax/SyntaxVisitor.h"
+#include "slang/text/SourceManager.h"
 
 class SemanticModel {
 public:
@@ -749,3 +751,403 @@ TEST_CASE("Visit all file") {
 
     CHECK(count == 1456);
 }
+
+TEST_CASE("Syntax tree text edits") {
+    std::string text = R"(
+`define FOO 1
+module m;
+    int i;
+    initial begin
+        i = 1;
+        i = 2;
+    end
+    class C;
+        int j = 3;
+    endclass
+endmodule
+
+module n; endmodule
+)";
+    auto oldTree = SyntaxTree::fromText(text);
+    auto& sm = oldTree->sourceManager();
+
+    auto applyEdit = [&](std::string_view find, std::string_view replacement) {
+        auto offset = text.find(find);
+        REQUIRE(offset != std::string::npos);
+
+        auto newTree = SyntaxTree::fromTextEdit(*oldTree, offset, find.size(), replacement);
+        REQUIRE(newTree);
+
+        text.replace(offset, find.size(), replacement);
+        CHECK(SyntaxPrinter::printFile(*newTree) == text);
+
+        auto fullTree = SyntaxTree::fromText(text);
+        CHECK(newTree->root().isEquivalentTo(fullTree->root()));
+        CHECK(newTree->diagnostics().size() == fullTree->diagnostics().size());
+
+        auto last = newTree->root().getLastToken();
+        CHECK(sm.getSourceText(last.location().buffer()).substr(0, text.size()) == text);
+        CHECK(last.location().offset() == text.size());
+
+        oldTree = newTree;
+    };
+
+    // Edits inside a statement, a class item, and a module item.
+    applyEdit("i = 2;", "i = 2 + 40;");
+    applyEdit("int j = 3;", "int jj = 4;");
+    applyEdit("int i;", "int i, k;");
+
+    // Edits that need a full parse: macro usage, spanning members, syntax errors.
+    applyEdit("i = 1;", "i = `FOO;");
+    applyEdit("endmodule\n\nmodule n;", "endmodule\nmodule p;");
+    applyEdit("i = 2 + 40;", "i = 2 +;");
+
+    auto& cu = oldTree->root().as<CompilationUnitSyntax>();
+    CHECK(cu.members[1]->as<ModuleDeclarationSyntax>().header->name.valueText() == "p");
+}
+
+TEST_CASE("Syntax tree text edits share unchanged syntax") {
+    std::string text = R"(
+`default_nettype tri
+module a; endmodule
+module m;
+    int i;
+    int j;
+    initial begin
+        i = 1;
+        i = 2;
+        i = 3;
+    end
+    class C;
+        int x;
+        int y;
+        int z;
+    endclass
+    assign w = 1;
+    int l;
+endmodule
+module b; endmodule
+)";
+    auto oldTree = SyntaxTree::fromText(text);
+
+    auto getMember = [](const SyntaxTree& tree, size_t module, size_t index) {
+        auto& cu = tree.root().as<CompilationUnitSyntax>();
+        return cu.members[module]->as<ModuleDeclarationSyntax>().members[index];
+    };
+
+    auto applyEdit = [&](std::string_view find, std::string_view replacement) {
+        auto offset = text.find(find);
+        REQUIRE(offset != std::string::npos);
+
+        auto newTree = SyntaxTree::fromTextEdit(*oldTree, offset, find.size(), replacement);
+        REQUIRE(newTree);
+
+        text.replace(offset, find.size(), replacement);
+        CHECK(SyntaxPrinter::printFile(*newTree) == text);
+
+        auto fullTree = SyntaxTree::fromText(text);
+        CHECK(newTree->root().isEquivalentTo(fullTree->root()));
+
+        // The preprocessor state recorded for each module must survive the edit.
+        auto& newCu = newTree->root().as<CompilationUnitSyntax>();
+        auto& fullCu = fullTree->root().as<CompilationUnitSyntax>();
+        auto& newMap = newTree->getMetadata().nodeMap;
+        auto& fullMap = fullTree->getMetadata().nodeMap;
+        REQUIRE(newMap.size() == fullMap.size());
+        for (size_t i = 0; i < newCu.members.size(); i++) {
+            REQUIRE(newMap.contains(newCu.members[i]));
+            CHECK(newMap.at(newCu.members[i]).defaultNetType ==
+                  fullMap.at(fullCu.members[i]).defaultNetType);
+        }
+
+        auto oldTreeRef = oldTree;
+        oldTree = newTree;
+        return oldTreeRef;
+    };
+
+    // A change in length moves everything after the edit, so only the
+    // syntax before it can be shared.
+    auto prev = applyEdit("i = 2;", "i = 2 + 40;");
+    CHECK(getMember(*oldTree, 1, 1) == getMember(*prev, 1, 1));
+    CHECK(getMember(*oldTree, 1, 4) != getMember(*prev, 1, 4));
+
+    // Edits that keep every line break in place share the syntax after them too.
+    prev = applyEdit("i = 1;", "i = 5;");
+    CHECK(getMember(*oldTree, 1, 1) == getMember(*prev, 1, 1));
+    CHECK(getMember(*oldTree, 1, 4) == getMember(*prev, 1, 4));
+
+    // The class is copied on the way down to the edited item, so the
+    // metadata needs to point at the copy.
+    applyEdit(" y;", " yy;");
+    auto& classDecls = oldTree->getMetadata().classDecls;
+    REQUIRE(classDecls.size() == 1);
+    CHECK(classDecls[0] == getMember(*oldTree, 1, 3));
+
+    // Old trees are kept alive by the trees derived from them.
+    prev.reset();
+
+    Compilation compilation;
+    compilation.addSyntaxTree(oldTree);
+    NO_COMPILATION_ERRORS;
+
+    auto& w = compilation.getRoot().lookupName<NetSymbol>("m.w");
+    CHECK(w.netType.netKind == NetType::Tri);
+}
+
+TEST_CASE("Syntax printer output sink") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+
+
+    int i = 1;
+    // comment
+    int j = 2;
+endmodule
+)");
+
+    auto expected = SyntaxPrinter().print(*tree).str();
+
+    std::string streamed;
+    size_t chunks = 0;
+    SyntaxPrinter printer;
+    printer.setOutputSink(
+        [&](std::string_view text) {
+            streamed += text;
+            chunks++;
+        },
+        4);
+
+    printer.print(*tree).flush();
+    CHECK(printer.str().empty());
+    CHECK(streamed == expected);
+    CHECK(chunks > 1);
+}
+
+TEST_CASE("Syntax printer slice sink") {
+    auto tree = SyntaxTree::fromText(R"(
+`define FOO 1
+module m;
+
+
+    int i = `FOO;
+    // comment
+    int j = 2;
+    function void foo(int i);
+    endfunction
+endmodule
+)");
+
+    tree = TestRewriter(tree).transform(tree);
+
+    std::string streamed;
+    size_t slices = 0;
+    SyntaxPrinter::printFile(*tree, [&](std::string_view text) {
+        streamed += text;
+        slices++;
+    });
+    CHECK(streamed == SyntaxPrinter::printFile(*tree));
+
+    // Unmodified text is merged into a handful of slices rather than one per token.
+    CHECK(slices < 10);
+
+    std::string squashed;
+    SyntaxPrinter printer;
+    printer.setSliceSink([&](std::string_view text) { squashed += text; });
+    printer.print(*tree).append("// end\n").flush();
+    CHECK(squashed == SyntaxPrinter().print(*tree).append("// end\n").str());
+}
+
+template<bool ExplicitStack>
+struct TraceSyntaxVisitor : public SyntaxVisitor<TraceSyntaxVisitor<ExplicitStack>, ExplicitStack> {
+    std::string trace;
+
+    void handle(const BinaryExpressionSyntax& syntax) {
+        trace += "(";
+        this->visitDefault(syntax);
+        trace += ")";
+    }
+
+    void handle(const DataDeclarationSyntax& syntax) {
+        trace += "decl:";
+        this->visitDefault(syntax);
+    }
+
+    void visitToken(Token token) { trace += token.rawText(); }
+};
+
+template<bool ExplicitStack>
+struct TraceASTVisitor
+    : public ASTVisitor<TraceASTVisitor<ExplicitStack>, true, true, false, ExplicitStack> {
+    std::string trace;
+
+    void handle(const BinaryExpression& expr) {
+        trace += "(";
+        this->visitDefault(expr);
+        trace += ")";
+    }
+
+    void handle(const NamedValueExpression& expr) { trace += expr.symbol.name; }
+
+    void handle(const IntegerLiteral& expr) { trace += expr.getValue().toString(); }
+
+    void handle(const StatementBlockSymbol& symbol) {
+        trace += "block:";
+        this->visitDefault(symbol);
+    }
+};
+
+TEST_CASE("Explicit stack visitors") {
+    auto tree = SyntaxTree::fromText(R"(
+module m;
+    int i = 1 + 2 * 3;
+    initial begin : b
+        automatic int j = i - (i + 4);
+        if (i > 2) j = i * 5 + j;
+    end
+endmodule
+)");
+
+    TraceSyntaxVisitor<false> recursiveSyntax;
+    TraceSyntaxVisitor<true> explicitSyntax;
+    tree->root().visit(recursiveSyntax);
+    tree->root().visit(explicitSyntax);
+    CHECK(explicitSyntax.trace == recursiveSyntax.trace);
+    CHECK(explicitSyntax.trace.starts_with("modulem;decl:inti=(1+(2*3));"));
+
+    Compilation compilation;
+    compilation.addSyntaxTree(tree);
+    NO_COMPILATION_ERRORS;
+
+    TraceASTVisitor<false> recursiveAST;
+    TraceASTVisitor<true> explicitAST;
+    compilation.getRoot().visit(recursiveAST);
+    compilation.getRoot().visit(explicitAST);
+    CHECK(explicitAST.trace == recursiveAST.trace);
+    CHECK(explicitAST.trace.starts_with("(1(23))"));
+    CHECK(explicitAST.trace.find("block:") != std::string::npos);
+    CHECK(explicitAST.trace.find("(i(i4))") != std::string::npos);
+}
+
+TEST_CASE("Explicit stack syntax visitor on deep expression chain") {
+    // Left-associative operator chains are parsed iteratively, so only
+    // the visitor needs to avoid recursing through each nested node.
+    const int terms = 50000;
+    std::string text = "module m; localparam int p = 1";
+    for (int i = 1; i < terms; i++)
+        text += " + 1";
+    text += "; endmodule";
+
+    auto tree = SyntaxTree::fromText(text);
+    CHECK(tree->diagnostics().empty());
+
+    struct CountVisitor : public SyntaxVisitor<CountVisitor, true> {
+        int literals = 0;
+        void handle(const LiteralExpressionSyntax&) { literals++; }
+    };
+
+    CountVisitor visitor;
+    tree->root().visit(visitor);
+    CHECK(visitor.literals == terms);
+}
+
+TEST_CASE("Parallel rewriting over compilation unit members") {
+    std::string text;
+    for (int i = 0; i < 24; i++) {
+        text += fmt::format(R"(
+module M{0};
+    typedef enum int {{ FOO = 1, BAR = 2, BAZ = {0} }} test_t;
+
+    function void foo(int i, output r);
+    endfunction
+endmodule
+)",
+                            i + 3);
+    }
+
+    // Handlers run on worker threads, so they can't use test assertions.
+    struct PortRewriter : public RewriterBase<PortRewriter> {
+        void handle(const TypedefDeclarationSyntax& decl) {
+            insertAfter(decl, parse(fmt::format("\n    localparam int {}__seen = 1;",
+                                                decl.name.valueText())));
+        }
+
+        void handle(const FunctionDeclarationSyntax& decl) {
+            auto portList = decl.prototype->portList;
+            if (!portList)
+                return;
+
+            insertAtFront(portList->ports, makeArg("argA"), makeComma());
+            insertAtBack(portList->ports, makeArg("argZ"), makeComma());
+        }
+    };
+
+    auto tree = SyntaxTree::fromText(text);
+    auto serial = PortRewriter().transform(tree);
+    auto parallel = PortRewriter::transformParallel(tree, [] { return PortRewriter(); }, 4);
+
+    CHECK(parallel != tree);
+    auto result = SyntaxPrinter::printFile(*parallel);
+    CHECK(result == SyntaxPrinter::printFile(*serial));
+    CHECK(result.find("localparam int test_t__seen = 1;") != std::string::npos);
+    CHECK(result.find("function void foo(argA,int i, output r,argZ);") != std::string::npos);
+}
+
+TEST_CASE("Parallel rewriting errors and serial fallback") {
+    std::string text;
+    for (int i = 0; i < 24; i++)
+        text += fmt::format("module M{}; endmodule\n", i);
+
+    auto tree = SyntaxTree::fromText(text);
+    auto& members = tree->root().as<CompilationUnitSyntax>().members;
+
+    // A handler that throws on one member has its exception rethrown
+    // once the other chunks are done.
+    struct ThrowingRewriter : public RewriterBase<ThrowingRewriter> {
+        void handle(const ModuleDeclarationSyntax& decl) {
+            if (decl.header->name.valueText() == "M13")
+                throw std::runtime_error("handler failed");
+        }
+    };
+
+    CHECK_THROWS_AS(ThrowingRewriter::transformParallel(tree, [] { return ThrowingRewriter(); }, 4),
+                    std::runtime_error);
+
+    // Every chunk replaces the same node, which only gets caught when
+    // the chunks are merged.
+    struct ConflictRewriter : public RewriterBase<ConflictRewriter> {
+        explicit ConflictRewriter(const SyntaxNode& target) : target(&target) {}
+
+        void handle(const ModuleDeclarationSyntax&) {
+            if (!replaced) {
+                replace(*target, parse("module X; endmodule"));
+                replaced = true;
+            }
+        }
+
+        const SyntaxNode* target;
+        bool replaced = false;
+    };
+
+    CHECK_THROWS_AS(ConflictRewriter::transformParallel(
+                        tree, [&] { return ConflictRewriter(*members[0]); }, 4),
+                    std::logic_error);
+
+    // A handler for the typed member list needs to see the whole list,
+    // so the members must not be split across threads.
+    struct ListRewriter : public RewriterBase<ListRewriter> {
+        explicit ListRewriter(std::vector<std::thread::id>& threads) : threads(&threads) {}
+
+        void handle(const SyntaxList<MemberSyntax>&) {}
+
+        void handle(const ModuleDeclarationSyntax&) {
+            threads->push_back(std::this_thread::get_id());
+        }
+
+        std::vector<std::thread::id>* threads;
+    };
+
+    std::vector<std::thread::id> threads;
+    ListRewriter::transformParallel(tree, [&] { return ListRewriter(threads); }, 4);
+    CHECK(threads.size() == members.size());
+    CHECK(std::ranges::all_of(threads, [](auto id) { return id == std::this_thread::get_id(); }));
+}
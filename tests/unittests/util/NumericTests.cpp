@@ -248,6 +248,46 @@ TEST_CASE("SVInt to string (and back)") {
     CHECK(str == SVInt::fromString(str).toString());
 }
 
+TEST_CASE("SVInt large literal conversions") {
+    // Build up a long pseudo-random digit string so that the conversions
+    // have to go through the divide-and-conquer paths.
+    std::string digits = "9";
+    uint32_t seed = 12345;
+    for (int i = 0; i < 5000; i++) {
+        seed = seed * 1103515245 + 12345;
+        digits.push_back(char('0' + (seed >> 16) % 10));
+    }
+
+    auto toStr = [](const SVInt& value, LiteralBase base) {
+        return value.toString(base, true, SVInt::MAX_BITS);
+    };
+
+    auto dec = "16620'd" + digits;
+    SVInt value = SVInt::fromString(dec);
+    CHECK(toStr(value, LiteralBase::Decimal) == dec);
+
+    auto hex = toStr(value, LiteralBase::Hex);
+    SVInt fromHex = SVInt::fromString(hex);
+    CHECK(fromHex == value);
+    CHECK(toStr(fromHex, LiteralBase::Decimal) == dec);
+
+    auto bin = toStr(value, LiteralBase::Binary);
+    CHECK(SVInt::fromString(bin) == value);
+
+    auto oct = toStr(value, LiteralBase::Octal);
+    CHECK(SVInt::fromString(oct) == value);
+
+    // Digits that don't fit are truncated from the left.
+    CHECK(SVInt::fromString("100'd" + digits) == value.trunc(100));
+
+    // Powers of ten have long runs of zeros that need to be padded
+    // in the split halves of the output.
+    auto pow10 = "20000'd1" + std::string(4000, '0');
+    CHECK(toStr(SVInt::fromString(pow10), LiteralBase::Decimal) == pow10);
+
+    CHECK(toStr("16000'h1x0z"_si, LiteralBase::Hex) == "16000'h1x0z");
+}
+
 TEST_CASE("Comparison") {
     CHECK(SVInt(9000) == SVInt(1024, 9000, false));
     CHECK(SVInt(-4) == -4);
@@ -838,3 +878,36 @@ value = value >> 1
     compilation.addSyntaxTree(tree);
     compilation.getAllDiagnostics();
 }
+
+TEST_CASE("ConstantValue container copies are independent") {
+    ConstantValue::Elements elems;
+    for (int i = 0; i < 4; i++)
+        elems.emplace_back(SVInt(32, uint64_t(i), true));
+
+    ConstantValue arr(std::move(elems));
+    ConstantValue arrCopy = arr;
+    arrCopy.elements()[1] = SVInt(32, 42, true);
+    CHECK(arr.elements()[1].integer() == 1);
+    CHECK(arrCopy.elements()[1].integer() == 42);
+    CHECK(arr != arrCopy);
+
+    AssociativeArray aa;
+    aa.emplace(SVInt(32, 1, true), SVInt(32, 10, true));
+
+    ConstantValue map(std::move(aa));
+    ConstantValue mapCopy = map;
+    CHECK(map == mapCopy);
+    mapCopy.map()->emplace(SVInt(32, 2, true), SVInt(32, 20, true));
+    CHECK(map.size() == 1);
+    CHECK(mapCopy.size() == 2);
+
+    SVQueue q;
+    q.emplace_back(SVInt(32, 5, true));
+
+    ConstantValue queue(std::move(q));
+    ConstantValue queueCopy = queue;
+    queueCopy.queue()->emplace_back(SVInt(32, 6, true));
+    queue.queue()->front() = SVInt(32, 7, true);
+    CHECK(queue.toString() == "[7]");
+    CHECK(queueCopy.toString() == "[5,6]");
+}
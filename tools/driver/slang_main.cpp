@@ -140,6 +140,13 @@ int driverMain(int argc, TArgs argv) {
             return 3;
         }
 
+        if (driver.options.diagJson == "-" &&
+            (onlyPreprocess == true || onlyMacros == true || astJsonFile == "-")) {
+            OS::printE(fg(driver.diagClient->errorColor), "error: ");
+            OS::printE("'--diag-json -' can't be combined with other output written to stdout");
+            return 3;
+        }
+
         if (timeTrace)
             TimeTrace::initialize();
 
@@ -42,7 +42,10 @@ int main(int argc, char** argv) {
         _setmode(_fileno(stdout), _O_BINARY);
 #endif
 
-        printf("%s", SyntaxPrinter::printFile(*tree.value()).c_str());
+        // Unmodified source text is written straight from the original buffer.
+        SyntaxPrinter::printFile(*tree.value(), [](std::string_view text) {
+            fwrite(text.data(), 1, text.size(), stdout);
+        });
         return 0;
     }
     SLANG_CATCH(const std::exception& e) {